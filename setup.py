@@ -96,6 +96,7 @@ setup(
     'Programming Language :: Cython',
     'Topic :: Scientific/Engineering :: Mathematics'],
     ext_modules = extensions,
+    install_requires = ['numpy'],
     packages = ['pyscipopt'],
     package_dir = {'pyscipopt': packagedir},
     package_data = {'pyscipopt': ['scip.pyx', 'scip.pxd', '*.pxi']}
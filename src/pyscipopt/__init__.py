@@ -21,8 +21,11 @@ from pyscipopt.scip      import Prop
 from pyscipopt.scip      import Sepa
 from pyscipopt.scip      import LP
 from pyscipopt.scip      import Expr
+from pyscipopt.scip      import MatrixExpr
 from pyscipopt.scip      import quicksum
 from pyscipopt.scip      import quickprod
+from pyscipopt.scip      import quickdot
+from pyscipopt.scip      import setMaxPowerTerms
 from pyscipopt.scip      import exp
 from pyscipopt.scip      import log
 from pyscipopt.scip      import sqrt
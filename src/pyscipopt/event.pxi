@@ -82,7 +82,6 @@ cdef SCIP_RETCODE PyEventDelete (SCIP* scip, SCIP_EVENTHDLR* eventhdlr, SCIP_EVE
 
 cdef SCIP_RETCODE PyEventExec (SCIP* scip, SCIP_EVENTHDLR* eventhdlr, SCIP_EVENT* event, SCIP_EVENTDATA* eventdata):
     PyEventhdlr = getPyEventhdlr(eventhdlr)
-    PyEvent = Event()
-    PyEvent.event = event
+    PyEvent = Event.create(event, _wrappersof(scip))
     PyEventhdlr.eventexec(PyEvent)
     return SCIP_OKAY
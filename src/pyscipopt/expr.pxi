@@ -33,28 +33,35 @@
 # Maybe when consexpr is released it makes sense to revisit this.
 # TODO: We have to think about the operations that we define: __isub__, __add__, etc
 # and when to copy expressions and when to not copy them.
-# For example: when creating a ExprCons from an Expr expr, we store the expression expr
-# and then we normalize. When doing the normalization, we do
-# ```
-# c = self.expr[CONST]
-# self.expr -= c
-# ```
-# which should, in princple, modify the expr. However, since we do not implement __isub__, __sub__
-# gets called (I guess) and so a copy is returned.
-# Modifying the expression directly would be a bug, given that the expression might be re-used by the user. </pre>
-
-
-def _is_number(e):
+# For example: when creating a ExprCons from an Expr expr, we normalize, i.e., we move the constant
+# to the sides and drop zero coefficients. Modifying the expression directly would be a bug, given that
+# the expression might be re-used by the user, so the normalization builds the normalized terms in a
+# single pass into a new expression; the bounds of an ExprCons are added later without copying again. </pre>
+
+
+# numpy scalars are numbers as well
+_NUMPY_SCALAR_TYPES = (np.number, np.bool_)
+
+cpdef bint _is_number(e):
+    # the common cases are decided by type, without converting or raising
+    if PyFloat_Check(e) or PyLong_Check(e):
+        return True
+    if isinstance(e, Expr) or isinstance(e, GenExpr) or isinstance(e, ExprCons):
+        return False
+    if isinstance(e, _NUMPY_SCALAR_TYPES):
+        return True
     try:
         f = float(e)
         return True
     except ValueError: # for malformed strings
         return False
-    except TypeError: # for other types (Variable, Expr)
+    except TypeError: # for other types
         return False
 
 
 def _expr_richcmp(self, other, op):
+    if isinstance(other, MatrixExpr):
+        return NotImplemented
     if op == 1: # <=
         if isinstance(other, Expr) or isinstance(other, GenExpr):
             return (self - other) <= 0.0
@@ -80,15 +87,20 @@ def _expr_richcmp(self, other, op):
         raise NotImplementedError
 
 
+# all existing terms by their pointer tuples, such that equal terms are usually the same object
+_termcache = weakref.WeakValueDictionary()
+
 class Term:
-    '''This is a monomial term'''
+    '''This is a monomial term; equal terms are usually represented by the same object'''
 
-    __slots__ = ('vartuple', 'ptrtuple', 'hashval')
+    __slots__ = ('vartuple', 'ptrtuple', 'hashval', '__weakref__')
 
-    def __init__(self, *vartuple):
-        self.vartuple = tuple(sorted(vartuple, key=lambda v: v.ptr()))
-        self.ptrtuple = tuple(v.ptr() for v in self.vartuple)
-        self.hashval = sum(self.ptrtuple)
+    def __new__(cls, *vartuple):
+        vartuple = tuple(sorted(vartuple, key=lambda v: v.ptr()))
+        return _internterm(vartuple, tuple(v.ptr() for v in vartuple))
+
+    def __reduce__(self):
+        return (Term, self.vartuple)
 
     def __getitem__(self, idx):
         return self.vartuple[idx]
@@ -97,7 +109,11 @@ class Term:
         return self.hashval
 
     def __eq__(self, other):
-        return self.ptrtuple == other.ptrtuple
+        # terms are interned, so the pointers only have to be compared if there are several wrappers of a variable
+        return self is other or self.ptrtuple == other.ptrtuple
+
+    def __ne__(self, other):
+        return not self == other
 
     def __len__(self):
         return len(self.vartuple)
@@ -115,9 +131,146 @@ class Term:
         for var in self.vartuple:
             prod *= point[var]
         return prod
-        
+
+cdef _internterm(tuple vartuple, tuple ptrtuple):
+    '''returns the Term of the given variables, which have to be sorted by their pointers'''
+    term = _termcache.get(ptrtuple)
+    # a term of other wrappers, e.g., of a freed variable at the same address, is replaced
+    if term is None or not _samevars(term.vartuple, vartuple):
+        term = object.__new__(Term)
+        term.vartuple = vartuple
+        term.ptrtuple = ptrtuple
+        # the tuple hash mixes the pointers, unlike their sum
+        term.hashval = hash(ptrtuple)
+        _termcache[ptrtuple] = term
+    return term
+
+cdef inline bint _samevars(tuple vars1, tuple vars2):
+    '''whether two variable tuples of the same pointers consist of the same wrappers'''
+    cdef Py_ssize_t i
+    if vars1 is vars2:
+        return True
+    for i in range(len(vars1)):
+        if vars1[i] is not vars2[i]:
+            return False
+    return True
+
 CONST = Term()
 
+# maximal number of terms of an expanded power of an Expr, negative for no limit, see setMaxPowerTerms()
+cdef Py_ssize_t _maxpowterms = -1
+
+def setMaxPowerTerms(nterms):
+    '''sets the maximal number of terms that the expansion of an integer power of an Expr may have;
+    larger powers are kept as general power expressions. None removes the limit, which is the default.
+
+    the number of terms of the expansion is estimated by the number of multisets of terms of the base'''
+    global _maxpowterms
+    _maxpowterms = -1 if nterms is None else nterms
+
+cdef bint _exceedsmultisets(Py_ssize_t m, int n, Py_ssize_t limit):
+    '''whether the number binomial(m + n - 1, n) of multisets of n out of m elements exceeds limit'''
+    # the partial products binomial(m - 1 + i, i) only grow with i, so we can stop as soon as one exceeds limit
+    count = 1
+    for i in range(1, n + 1):
+        count = count * (m - 1 + i) // i
+        if count > limit:
+            return True
+    return False
+
+cdef dict _termpower(dict terms, int n):
+    '''expands the n-th power of a polynomial given by its dictionary of terms to coefficients
+
+    by the multinomial theorem, every multiset of n terms is enumerated once; if term i occurs k_i times,
+    the product gets the coefficient n!/(k_1!...k_m!) times the product of the coefficients to the power k_i'''
+    cdef dict products = {} # pointer tuple -> [variable tuple, coefficient]
+    cdef list items = [(t.vartuple, t.ptrtuple, c) for t, c in terms.items() if c != 0.0]
+    cdef list fact = [math.factorial(k) for k in range(n + 1)]
+    cdef tuple v, p
+    cdef int i, j, k
+
+    for combo in itertools.combinations_with_replacement(range(len(items)), n):
+        multinomial = fact[n]
+        coef = 1.0
+        v = ()
+        p = ()
+        j = 0
+        while j < n:
+            i = combo[j]
+            k = 1
+            while j + k < n and combo[j + k] == i:
+                k += 1
+            vi, pi, ci = items[i]
+            multinomial //= fact[k]
+            coef *= ci**k
+            v += vi * k
+            p += pi * k
+            j += k
+
+        if len(p) > 1:
+            order = sorted(range(len(p)), key=p.__getitem__)
+            v = tuple([v[o] for o in order])
+            p = tuple([p[o] for o in order])
+
+        entry = products.get(p)
+        if entry is None:
+            products[p] = [v, multinomial * coef]
+        else:
+            entry[1] += multinomial * coef
+
+    return {_internterm(v, p) : c for p, (v, c) in products.items()}
+
+cdef dict _termproduct(dict terms1, dict terms2):
+    '''multiplies two polynomials given by their dictionaries of terms to coefficients
+
+    the variables of a term are sorted by pointer, so the product of two terms is the merge of
+    two sorted tuples. products are accumulated by their pointer tuples, such that a Term is
+    only created once for every distinct product'''
+    cdef dict products = {} # pointer tuple -> [variable tuple, coefficient]
+    cdef list right = [(t.vartuple, t.ptrtuple, c) for t, c in terms2.items()]
+    cdef tuple v1, p1, v2, p2, v, p
+    cdef Py_ssize_t n1, n2, i, j
+
+    for t1, c1 in terms1.items():
+        v1 = t1.vartuple
+        p1 = t1.ptrtuple
+        n1 = len(p1)
+        for v2, p2, c2 in right:
+            n2 = len(p2)
+            if n2 == 0:
+                v, p = v1, p1
+            elif n1 == 0:
+                v, p = v2, p2
+            elif n1 == 1 and n2 == 1:
+                # bilinear and quadratic terms are ordered canonically
+                if <size_t>p1[0] <= <size_t>p2[0]:
+                    v, p = v1 + v2, p1 + p2
+                else:
+                    v, p = v2 + v1, p2 + p1
+            else:
+                vs = []
+                ps = []
+                i = j = 0
+                while i < n1 and j < n2:
+                    if <size_t>p1[i] <= <size_t>p2[j]:
+                        vs.append(v1[i])
+                        ps.append(p1[i])
+                        i += 1
+                    else:
+                        vs.append(v2[j])
+                        ps.append(p2[j])
+                        j += 1
+                v = tuple(vs) + v1[i:] + v2[j:]
+                p = tuple(ps) + p1[i:] + p2[j:]
+
+            entry = products.get(p)
+            if entry is None:
+                products[p] = [v, c1 * c2]
+            else:
+                entry[1] += c1 * c2
+
+    return {_internterm(v, p) : c for p, (v, c) in products.items()}
+
 # helper function
 def buildGenExprObj(expr):
     """helper function to generate an object of type GenExpr"""
@@ -145,6 +298,13 @@ def buildGenExprObj(expr):
         assert isinstance(expr, GenExpr)
         return expr
 
+# helper function
+cdef inline _termsof(Expr expr):
+    """returns the terms of an expression; a Variable creates its single term only when first needed"""
+    if expr.terms is None:
+        expr.terms = {Term(expr) : 1.0}
+    return expr.terms
+
 ##@details Polynomial expressions of variables with operator overloading. \n
 #See also the @ref ExprDetails "description" in the expr.pxi. 
 cdef class Expr:
@@ -161,13 +321,13 @@ cdef class Expr:
     def __getitem__(self, key):
         if not isinstance(key, Term):
             key = Term(key)
-        return self.terms.get(key, 0.0)
+        return _termsof(self).get(key, 0.0)
 
     def __iter__(self):
-        return iter(self.terms)
+        return iter(_termsof(self))
 
     def __next__(self):
-        try: return next(self.terms)
+        try: return next(_termsof(self))
         except: raise StopIteration
 
     def __abs__(self):
@@ -191,22 +351,27 @@ cdef class Expr:
             terms[CONST] = terms.get(CONST, 0.0) + c
         elif isinstance(right, GenExpr):
             return buildGenExprObj(left) + right
+        elif isinstance(right, MatrixExpr):
+            return NotImplemented
         else:
             raise NotImplementedError
         return Expr(terms)
 
     def __iadd__(self, other):
+        terms = _termsof(self)
         if isinstance(other, Expr):
             for v,c in other.terms.items():
-                self.terms[v] = self.terms.get(v, 0.0) + c
+                terms[v] = terms.get(v, 0.0) + c
         elif _is_number(other):
             c = float(other)
-            self.terms[CONST] = self.terms.get(CONST, 0.0) + c
+            terms[CONST] = terms.get(CONST, 0.0) + c
         elif isinstance(other, GenExpr):
-            # is no longer in place, might affect performance?
-            # can't do `self = buildGenExprObj(self) + other` since I get
-            # TypeError: Cannot convert pyscipopt.scip.SumExpr to pyscipopt.scip.Expr
-            return buildGenExprObj(self) + other
+            # the result is a fresh SumExpr, further additions to it are in place
+            ans = buildGenExprObj(self)
+            _sum_into(ans, other)
+            return ans
+        elif isinstance(other, MatrixExpr):
+            return NotImplemented
         else:
             raise NotImplementedError
         return self
@@ -214,19 +379,16 @@ cdef class Expr:
     def __mul__(self, other):
         if _is_number(other):
             f = float(other)
-            return Expr({v:f*c for v,c in self.terms.items()})
+            return Expr({v:f*c for v,c in _termsof(self).items()})
         elif _is_number(self):
             f = float(self)
             return Expr({v:f*c for v,c in other.terms.items()})
         elif isinstance(other, Expr):
-            terms = {}
-            for v1, c1 in self.terms.items():
-                for v2, c2 in other.terms.items():
-                    v = v1 + v2
-                    terms[v] = terms.get(v, 0.0) + c1 * c2
-            return Expr(terms)
+            return Expr(_termproduct(_termsof(self), _termsof(other)))
         elif isinstance(other, GenExpr):
             return buildGenExprObj(self) * other
+        elif isinstance(other, MatrixExpr):
+            return NotImplemented
         else:
             raise NotImplementedError
 
@@ -251,13 +413,16 @@ cdef class Expr:
         else: # need to transform to GenExpr
             return buildGenExprObj(self)**other
 
-        res = 1
-        for _ in range(exp):
-            res *= self
-        return res
+        if exp == 0:
+            return 1
+        terms = _termsof(self)
+        if _maxpowterms >= 0 and _exceedsmultisets(len(terms), exp, _maxpowterms):
+            # the expansion might get too large, see setMaxPowerTerms()
+            return buildGenExprObj(self)**exp
+        return Expr(_termpower(terms, exp))
 
     def __neg__(self):
-        return Expr({v:-c for v,c in self.terms.items()})
+        return Expr({v:-c for v,c in _termsof(self).items()})
 
     def __sub__(self, other):
         return self + (-other)
@@ -277,21 +442,21 @@ cdef class Expr:
 
     def normalize(self):
         '''remove terms with coefficient of 0'''
-        self.terms =  {t:c for (t,c) in self.terms.items() if c != 0.0}
+        self.terms =  {t:c for (t,c) in _termsof(self).items() if c != 0.0}
 
     def __repr__(self):
-        return 'Expr(%s)' % repr(self.terms)
+        return 'Expr(%s)' % repr(_termsof(self))
 
     def degree(self):
         '''computes highest degree of terms'''
-        if len(self.terms) == 0:
+        if len(_termsof(self)) == 0:
             return 0
         else:
-            return max(len(v) for v in self.terms)
+            return max(len(v) for v in _termsof(self))
 
     def _evaluate(self, point):
         '''computes the value of the expression in the given variable-value mapping.'''
-        return sum(term._evaluate(point)*coeff for term, coeff in self.terms.items() if coeff != 0)
+        return sum(term._evaluate(point)*coeff for term, coeff in _termsof(self).items() if coeff != 0)
 
 
 cdef class ExprCons:
@@ -299,21 +464,26 @@ cdef class ExprCons:
     cdef public expr
     cdef public _lhs
     cdef public _rhs
+    # constant moved from the expression to the bounds, also applied to a bound that is added later
+    cdef public double _constant
 
     def __init__(self, expr, lhs=None, rhs=None):
         self.expr = expr
         self._lhs = lhs
         self._rhs = rhs
+        self._constant = 0.0
         assert not (lhs is None and rhs is None)
         self.normalize()
 
     def normalize(self):
         '''move constant terms in expression to bounds'''
         if isinstance(self.expr, Expr):
-            c = self.expr[CONST]
-            self.expr -= c
-            assert self.expr[CONST] == 0.0
-            self.expr.normalize()
+            # split off the constant and drop zeros in one pass, leaving the given expression untouched
+            terms = _termsof(self.expr)
+            c = terms.get(CONST, 0.0)
+            self._constant = c
+            self.expr = Expr()
+            self.expr.terms = {t:coef for (t,coef) in terms.items() if coef != 0.0 and t is not CONST}
         else:
             assert isinstance(self.expr, GenExpr)
             return
@@ -335,7 +505,7 @@ cdef class ExprCons:
            if not _is_number(other):
                raise TypeError('Ranged ExprCons is not well defined!')
 
-           return ExprCons(self.expr, lhs=self._lhs, rhs=float(other))
+           return _normalizedcons(self.expr, self._lhs, float(other) - self._constant, self._constant)
         elif op == 5: # >=
            if not self._lhs is None:
                raise TypeError('ExprCons already has lower bound')
@@ -345,7 +515,7 @@ cdef class ExprCons:
            if not _is_number(other):
                raise TypeError('Ranged ExprCons is not well defined!')
 
-           return ExprCons(self.expr, lhs=float(other), rhs=self._rhs)
+           return _normalizedcons(self.expr, float(other) - self._constant, self._rhs, self._constant)
         else:
             raise TypeError
 
@@ -364,14 +534,76 @@ you have to use parenthesis to break the Python syntax for chained comparisons:
 """
         raise TypeError(msg)
 
+cdef ExprCons _normalizedcons(expr, lhs, rhs, double constant):
+    '''creates an ExprCons from an expression that is already normalized, which is not copied,
+    where constant has been moved from the expression to the bounds'''
+    cdef ExprCons cons = ExprCons.__new__(ExprCons)
+    cons.expr = expr
+    cons._lhs = lhs
+    cons._rhs = rhs
+    cons._constant = constant
+    return cons
+
 def quicksum(termlist):
     '''add linear expressions and constants much faster than Python's sum
     by avoiding intermediate data structures and adding terms inplace
+
+    general expressions are collected in a single sum, to which the polynomial part is added at the end
     '''
+    cdef SumExpr gensum = None
     result = Expr()
     for term in termlist:
-        result += term
-    return result
+        if isinstance(term, GenExpr):
+            if gensum is None:
+                gensum = SumExpr()
+            _sum_into(gensum, term)
+        else:
+            result += term
+    if gensum is None:
+        return result
+    _sum_into(gensum, buildGenExprObj(result))
+    return gensum
+
+def quickdot(coeffs, termlist):
+    '''computes the weighted sum of variables or expressions, e.g., quickdot(c, x) instead of
+    quicksum(c[i]*x[i] for i in I), in a single pass without intermediate expressions.
+
+    :param coeffs: coefficients, a numpy array or a sequence of numbers
+    :param termlist: sequence of variables, expressions or numbers of the same length; equal terms are merged
+    '''
+    cdef double[::1] _coeffs = np.ascontiguousarray(coeffs, dtype=np.double).ravel()
+    cdef SumExpr gensum = None
+    cdef dict terms = {CONST: 0.0}
+    cdef Variable var
+    cdef Py_ssize_t i = 0
+    cdef double c
+
+    if len(termlist) != _coeffs.shape[0]:
+        raise ValueError("expected %d terms, got %d" % (_coeffs.shape[0], len(termlist)))
+
+    for term in termlist:
+        c = _coeffs[i]
+        i += 1
+        if isinstance(term, Variable):
+            var = <Variable>term
+            key = _internterm((var,), (<size_t>var.scip_var,))
+            terms[key] = terms.get(key, 0.0) + c
+        elif isinstance(term, Expr):
+            for key, coef in _termsof(<Expr>term).items():
+                terms[key] = terms.get(key, 0.0) + c * coef
+        elif isinstance(term, GenExpr):
+            if gensum is None:
+                gensum = SumExpr()
+            _sum_into(gensum, c * term)
+        elif _is_number(term):
+            terms[CONST] += c * float(term)
+        else:
+            raise NotImplementedError
+
+    if gensum is None:
+        return Expr(terms)
+    _sum_into(gensum, buildGenExprObj(Expr(terms)))
+    return gensum
 
 def quickprod(termlist):
     '''multiply linear expressions and constants by avoiding intermediate 
@@ -417,7 +649,8 @@ Operator = Op()
 #@note
 #   - these expressions are not smart enough to identify equal terms
 #   - in contrast to polynomial expressions, __getitem__ is not implemented
-#     so expr[x] will generate an error instead of returning the coefficient of x </pre>
+#     so expr[x] will generate an error instead of returning the coefficient of x
+#   - sums and products are modified in place by += and *=, respectively, like polynomial expressions </pre>
 #
 #See also the @ref ExprDetails "description" in the expr.pxi. 
 cdef class GenExpr:
@@ -433,107 +666,17 @@ cdef class GenExpr:
         return UnaryExpr(Operator.fabs, self)
 
     def __add__(self, other):
-        left = buildGenExprObj(self)
-        right = buildGenExprObj(other)
         ans = SumExpr()
-
-        # add left term
-        if left.getOp() == Operator.add:
-            ans.coefs.extend(left.coefs)
-            ans.children.extend(left.children)
-            ans.constant += left.constant
-        elif left.getOp() == Operator.const:
-            ans.constant += left.number
-        else:
-            ans.coefs.append(1.0)
-            ans.children.append(left)
-
-        # add right term
-        if right.getOp() == Operator.add:
-            ans.coefs.extend(right.coefs)
-            ans.children.extend(right.children)
-            ans.constant += right.constant
-        elif right.getOp() == Operator.const:
-            ans.constant += right.number
-        else:
-            ans.coefs.append(1.0)
-            ans.children.append(right)
-
+        _sum_into(ans, buildGenExprObj(self))
+        _sum_into(ans, buildGenExprObj(other))
         return ans
 
-    #def __iadd__(self, other):
-    #''' in-place addition, i.e., expr += other '''
-    #    assert isinstance(self, Expr)
-    #    right = buildGenExprObj(other)
-    #
-    #    # transform self into sum
-    #    if self.getOp() != Operator.add:
-    #        newsum = SumExpr()
-    #        if self.getOp() == Operator.const:
-    #            newsum.constant += self.number
-    #        else:
-    #            newsum.coefs.append(1.0)
-    #            newsum.children.append(self.copy()) # TODO: what is copy?
-    #        self = newsum
-    #    # add right term
-    #    if right.getOp() == Operator.add:
-    #        self.coefs.extend(right.coefs)
-    #        self.children.extend(right.children)
-    #        self.constant += right.constant
-    #    elif right.getOp() == Operator.const:
-    #        self.constant += right.number
-    #    else:
-    #        self.coefs.append(1.0)
-    #        self.children.append(right)
-    #    return self
-
     def __mul__(self, other):
-        left = buildGenExprObj(self)
-        right = buildGenExprObj(other)
         ans = ProdExpr()
-
-        # multiply left factor
-        if left.getOp() == Operator.prod:
-            ans.children.extend(left.children)
-            ans.constant *= left.constant
-        elif left.getOp() == Operator.const:
-            ans.constant *= left.number
-        else:
-            ans.children.append(left)
-
-        # multiply right factor
-        if right.getOp() == Operator.prod:
-            ans.children.extend(right.children)
-            ans.constant *= right.constant
-        elif right.getOp() == Operator.const:
-            ans.constant *= right.number
-        else:
-            ans.children.append(right)
-
+        _prod_into(ans, buildGenExprObj(self))
+        _prod_into(ans, buildGenExprObj(other))
         return ans
 
-    #def __imul__(self, other):
-    #''' in-place multiplication, i.e., expr *= other '''
-    #    assert isinstance(self, Expr)
-    #    right = buildGenExprObj(other)
-    #    # transform self into prod
-    #    if self.getOp() != Operator.prod:
-    #        newprod = ProdExpr()
-    #        if self.getOp() == Operator.const:
-    #            newprod.constant *= self.number
-    #        else:
-    #            newprod.children.append(self.copy()) # TODO: what is copy?
-    #        self = newprod
-    #    # multiply right factor
-    #    if right.getOp() == Operator.prod:
-    #        self.children.extend(right.children)
-    #        self.constant *= right.constant
-    #    elif right.getOp() == Operator.const:
-    #        self.constant *= right.number
-    #    else:
-    #        self.children.append(right)
-    #    return self
-
     def __pow__(self, other, modulo):
         expo = buildGenExprObj(other)
         if expo.getOp() != Operator.const:
@@ -599,6 +742,10 @@ cdef class SumExpr(GenExpr):
         self.children = []
         self._op = Operator.add
         self.operatorIndex = Operator.operatorIndexDic[self._op]
+    def __iadd__(self, other):
+        ''' in-place addition, i.e., expr += other; the sum is extended instead of copied '''
+        _sum_into(self, buildGenExprObj(other))
+        return self
     def __repr__(self):
         return self._op + "(" + str(self.constant) + "," + ",".join(map(lambda child : child.__repr__(), self.children)) + ")"
 
@@ -610,6 +757,10 @@ cdef class ProdExpr(GenExpr):
         self.children = []
         self._op = Operator.prod
         self.operatorIndex = Operator.operatorIndexDic[self._op]
+    def __imul__(self, other):
+        ''' in-place multiplication, i.e., expr *= other; the product is extended instead of copied '''
+        _prod_into(self, buildGenExprObj(other))
+        return self
     def __repr__(self):
         return self._op + "(" + str(self.constant) + "," + ",".join(map(lambda child : child.__repr__(), self.children)) + ")"
 
@@ -655,6 +806,29 @@ cdef class Constant(GenExpr):
     def __repr__(self):
         return str(self.number)
 
+# helper functions adding a term to a sum, resp. multiplying a factor into a product, in place
+cdef _sum_into(SumExpr ans, GenExpr term):
+    op = term._op
+    if op == Operator.add:
+        ans.coefs.extend((<SumExpr>term).coefs)
+        ans.children.extend(term.children)
+        ans.constant += (<SumExpr>term).constant
+    elif op == Operator.const:
+        ans.constant += (<Constant>term).number
+    else:
+        ans.coefs.append(1.0)
+        ans.children.append(term)
+
+cdef _prod_into(ProdExpr ans, GenExpr factor):
+    op = factor._op
+    if op == Operator.prod:
+        ans.children.extend(factor.children)
+        ans.constant *= (<ProdExpr>factor).constant
+    elif op == Operator.const:
+        ans.constant *= (<Constant>factor).number
+    else:
+        ans.children.append(factor)
+
 def exp(expr):
     """returns expression with exp-function"""
     return UnaryExpr(Operator.exp, buildGenExprObj(expr))
@@ -666,41 +840,297 @@ def sqrt(expr):
     return UnaryExpr(Operator.sqrt, buildGenExprObj(expr))
 
 def expr_to_nodes(expr):
-    '''transforms tree to an array of nodes. each node is an operator and the position of the 
-    children of that operator (i.e. the other nodes) in the array'''
+    '''transforms tree to an array of nodes; SCIP expressions are created directly by _genexpr_to_scip().
+    each node is an operator and the position of the each node is an operator and the position of the 
+    children of that operator (i.e. the other nodes) in the array.
+    equal subexpressions and variables are stored only once, so a node may be the child of several nodes'''
     assert isinstance(expr, GenExpr)
     nodes = []
-    expr_to_array(expr, nodes)
+    expr_to_array(expr, nodes, {}, {})
     return nodes
 
-def value_to_array(val, nodes):
+def node_to_array(op, args, nodes, nodeindex=None):
+    """adds a node to an array unless nodeindex already knows an equal node, returns its position"""
+    if nodeindex is None:
+        nodes.append(tuple([op, args]))
+        return len(nodes) - 1
+    # children are identified by their position, variables by their pointer
+    key = (op, args[0].ptr()) if op == Operator.varidx else (op, tuple(args))
+    pos = nodeindex.get(key)
+    if pos is None:
+        nodes.append(tuple([op, args]))
+        pos = len(nodes) - 1
+        nodeindex[key] = pos
+    return pos
+
+def value_to_array(val, nodes, nodeindex=None):
     """adds a given value to an array"""
-    nodes.append(tuple(['const', [val]]))
-    return len(nodes) - 1
+    return node_to_array('const', [val], nodes, nodeindex)
 
 # there many hacky things here: value_to_array is trying to mimick
 # the multiple dispatch of julia. Also that we have to ask which expression is which
 # in order to get the constants correctly
 # also, for sums, we are not considering coefficients, because basically all coefficients are 1
 # haven't even consider substractions, but I guess we would interpret them as a - b = a + (-1) * b
-def expr_to_array(expr, nodes):
-    """adds expression to array"""
+def expr_to_array(expr, nodes, nodeindex=None, visited=None):
+    """adds expression to array
+
+    if given, nodeindex maps the nodes to their position and visited maps the ids of already added
+    expressions to their position, such that equal subexpressions are added only once"""
+    if visited is not None and id(expr) in visited:
+        return visited[id(expr)]
     op = expr._op
     if op == Operator.const: # FIXME: constant expr should also have children!
-        nodes.append(tuple([op, [expr.number]]))
+        pos = node_to_array(op, [expr.number], nodes, nodeindex)
     elif op != Operator.varidx:
         indices = []
         nchildren = len(expr.children)
         for child in expr.children:
-            pos = expr_to_array(child, nodes) # position of child in the final array of nodes, 'nodes'
+            pos = expr_to_array(child, nodes, nodeindex, visited) # position of child in the final array of nodes, 'nodes'
             indices.append(pos)
         if op == Operator.power:
-            pos = value_to_array(expr.expo, nodes)
+            pos = value_to_array(expr.expo, nodes, nodeindex)
             indices.append(pos)
         elif (op == Operator.add and expr.constant != 0.0) or (op == Operator.prod and expr.constant != 1.0):
-            pos = value_to_array(expr.constant, nodes)
+            pos = value_to_array(expr.constant, nodes, nodeindex)
             indices.append(pos)
-        nodes.append( tuple( [op, indices] ) )
+        pos = node_to_array(op, indices, nodes, nodeindex)
     else: # var
-        nodes.append( tuple( [op, expr.children] ) )
-    return len(nodes) - 1
+        pos = node_to_array(op, expr.children, nodes, nodeindex)
+    if visited is not None:
+        visited[id(expr)] = pos
+    return pos
+
+cdef SCIP_EXPR* _genexpr_to_scip(SCIP* scip, GenExpr expr, list variables) except NULL:
+    '''creates the SCIP expression of a general expression. the variables of the expression are appended to
+    variables, a variable expression refers to the position of its variable in there.
+
+    the expression graph is traversed with an explicit stack, so deep expressions do not hit the recursion limit.
+    equal subexpressions and variables are created only once; since SCIP expressions are trees,
+    an expression that is the child of several expressions is copied for all but its first parent'''
+    cdef BMS_BLKMEM* blkmem = SCIPblkmem(scip)
+    cdef SCIP_EXPR* scipexpr = NULL
+    cdef SCIP_EXPR* freeexpr
+    cdef SCIP_EXPR** children = NULL
+    cdef SCIP_EXPR** newchildren
+    cdef int maxchildren = 0
+    cdef int nchildren
+    cdef int pos
+    cdef int c
+    cdef list created = [] # pointers of the created SCIP expressions
+    cdef list used = [] # whether a created SCIP expression is the child of another one
+    cdef dict visited = {} # ids of python expressions to their position in created
+    cdef dict index = {} # keys of subexpressions to their position in created
+
+    stack = [(expr, False)]
+    try:
+        while stack:
+            e, expanded = stack.pop()
+            if id(e) in visited:
+                continue
+            op = e._op
+            if op == Operator.const:
+                key = (op, e.number)
+            elif op == Operator.varidx:
+                key = (op, e.children[0].ptr())
+            elif not expanded:
+                # create the children first
+                stack.append((e, True))
+                for child in reversed(e.children):
+                    stack.append((child, False))
+                continue
+            else:
+                # children are identified by their position, constants are part of the key
+                childpos = tuple([visited[id(child)] for child in e.children])
+                if op == Operator.power:
+                    key = (op, childpos, e.expo)
+                elif op == Operator.add or op == Operator.prod:
+                    key = (op, childpos, e.constant)
+                else:
+                    key = (op, childpos)
+            if key in index:
+                visited[id(e)] = index[key]
+                continue
+
+            opidx = e.operatorIndex
+            if opidx == SCIP_EXPR_CONST:
+                PY_SCIP_CALL( SCIPexprCreate(blkmem, &scipexpr, opidx, <SCIP_Real>e.number) )
+            elif opidx == SCIP_EXPR_VARIDX:
+                PY_SCIP_CALL( SCIPexprCreate(blkmem, &scipexpr, opidx, <int>len(variables)) )
+                variables.append(e.children[0])
+            else:
+                # one more for the constant of sums and products
+                nchildren = len(childpos)
+                if nchildren + 1 > maxchildren:
+                    maxchildren = 2 * (nchildren + 1)
+                    newchildren = <SCIP_EXPR**> realloc(children, maxchildren * sizeof(SCIP_EXPR*))
+                    if newchildren == NULL:
+                        raise MemoryError()
+                    children = newchildren
+                for c in range(nchildren):
+                    pos = childpos[c]
+                    if used[pos]:
+                        PY_SCIP_CALL( SCIPexprCopyDeep(blkmem, &children[c], <SCIP_EXPR*><size_t>created[pos]) )
+                    else:
+                        children[c] = <SCIP_EXPR*><size_t>created[pos]
+                        used[pos] = True
+
+                if opidx == SCIP_EXPR_SUM or opidx == SCIP_EXPR_PRODUCT:
+                    if (opidx == SCIP_EXPR_SUM and e.constant != 0.0) or (opidx == SCIP_EXPR_PRODUCT and e.constant != 1.0):
+                        PY_SCIP_CALL( SCIPexprCreate(blkmem, &children[nchildren], SCIP_EXPR_CONST, <SCIP_Real>e.constant) )
+                        nchildren += 1
+                    PY_SCIP_CALL( SCIPexprCreate(blkmem, &scipexpr, opidx, nchildren, children) )
+                elif opidx == SCIP_EXPR_REALPOWER:
+                    if float(e.expo).is_integer():
+                        PY_SCIP_CALL( SCIPexprCreate(blkmem, &scipexpr, SCIP_EXPR_INTPOWER, children[0], <int>e.expo) )
+                    else:
+                        PY_SCIP_CALL( SCIPexprCreate(blkmem, &scipexpr, opidx, children[0], <SCIP_Real>e.expo) )
+                elif opidx == SCIP_EXPR_EXP or opidx == SCIP_EXPR_LOG or opidx == SCIP_EXPR_SQRT or opidx == SCIP_EXPR_ABS:
+                    assert nchildren == 1
+                    PY_SCIP_CALL( SCIPexprCreate(blkmem, &scipexpr, opidx, children[0]) )
+                else:
+                    raise NotImplementedError
+
+            visited[id(e)] = index[key] = len(created)
+            created.append(<size_t>scipexpr)
+            used.append(False)
+
+        pos = visited[id(expr)]
+        used[pos] = True
+        return <SCIP_EXPR*><size_t>created[pos]
+    finally:
+        free(children)
+        # only needed if an error occurred
+        for pos in range(len(created)):
+            if not used[pos]:
+                freeexpr = <SCIP_EXPR*><size_t>created[pos]
+                SCIPexprFreeDeep(blkmem, &freeexpr)
+
+# operation codes of the evaluation tape, see _compile_tape()
+cdef enum:
+    TAPE_CONST = 0  # push vals[k]
+    TAPE_VAR        # push value of variable args[k]
+    TAPE_SUM        # pop args[k] values, push their sum plus vals[k]
+    TAPE_PROD       # pop args[k] values, push their product times vals[k]
+    TAPE_SCALE      # multiply top by vals[k]
+    TAPE_POW        # raise top to the power vals[k]
+    TAPE_EXP
+    TAPE_LOG
+    TAPE_SQRT
+    TAPE_ABS
+
+_TAPE_UNARY = {Operator.exp: TAPE_EXP, Operator.log: TAPE_LOG, Operator.sqrt: TAPE_SQRT, Operator.fabs: TAPE_ABS}
+
+def _compile_tape(expr, varindex, variables):
+    '''compiles an Expr or GenExpr into a flat tape of postfix instructions, see TAPE_*
+
+    varindex maps variable pointers to their position in variables; both are extended by new variables.
+    returns the arrays (ops, args, vals) of the tape and the maximal stack depth needed to run it'''
+    ops, args, vals = [], [], []
+
+    def emit(op, arg, val):
+        ops.append(op)
+        args.append(arg)
+        vals.append(val)
+
+    def emitvar(var):
+        ptr = var.ptr()
+        if ptr not in varindex:
+            varindex[ptr] = len(variables)
+            variables.append(var)
+        emit(TAPE_VAR, varindex[ptr], 0.0)
+
+    # the expression graph is traversed with an explicit stack, so deep expressions do not hit the recursion
+    # limit; an instruction on the stack is emitted once the operands pushed after it have been compiled
+    stack = [buildGenExprObj(expr) if _is_number(expr) else expr]
+    while stack:
+        expr = stack.pop()
+        if isinstance(expr, tuple):
+            emit(*expr)
+        elif isinstance(expr, Expr):
+            terms = expr.terms
+            for term, coef in terms.items():
+                for var in term:
+                    emitvar(var)
+                emit(TAPE_PROD, len(term), coef)
+            emit(TAPE_SUM, len(terms), 0.0)
+        else:
+            op = expr.getOp()
+            if op == Operator.const:
+                emit(TAPE_CONST, 0, expr.number)
+            elif op == Operator.varidx:
+                emitvar(expr.children[0])
+            elif op == Operator.add:
+                stack.append((TAPE_SUM, len(expr.children), expr.constant))
+                for child, coef in reversed(list(zip(expr.children, expr.coefs))):
+                    if coef != 1.0:
+                        stack.append((TAPE_SCALE, 0, coef))
+                    stack.append(child)
+            elif op == Operator.prod:
+                stack.append((TAPE_PROD, len(expr.children), expr.constant))
+                stack.extend(reversed(expr.children))
+            elif op == Operator.power:
+                stack.append((TAPE_POW, 0, expr.expo))
+                stack.append(expr.children[0])
+            elif op in _TAPE_UNARY:
+                stack.append((_TAPE_UNARY[op], 0, 0.0))
+                stack.append(expr.children[0])
+            else:
+                raise NotImplementedError("cannot evaluate operator %s" % op)
+
+    # every instruction pushes one value after popping its arguments
+    depth = maxdepth = 0
+    for op, arg in zip(ops, args):
+        if op == TAPE_CONST or op == TAPE_VAR:
+            depth += 1
+        elif op == TAPE_SUM or op == TAPE_PROD:
+            depth += 1 - arg
+        maxdepth = max(maxdepth, depth)
+
+    return (np.array(ops, dtype=np.intc), np.array(args, dtype=np.intc), np.array(vals, dtype=np.double)), maxdepth
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+cdef double _run_tape(int[::1] ops, int[::1] args, double[::1] vals, double[:, ::1] values, int col, double* stack) nogil:
+    '''runs a tape from _compile_tape() on column col of the matrix of variable values and returns the result'''
+    cdef int top = -1
+    cdef int k
+    cdef int j
+    cdef int n
+    cdef double acc
+
+    for k in range(ops.shape[0]):
+        if ops[k] == TAPE_CONST:
+            top += 1
+            stack[top] = vals[k]
+        elif ops[k] == TAPE_VAR:
+            top += 1
+            stack[top] = values[args[k], col]
+        elif ops[k] == TAPE_SUM:
+            n = args[k]
+            acc = vals[k]
+            for j in range(n):
+                acc += stack[top - j]
+            top += 1 - n
+            stack[top] = acc
+        elif ops[k] == TAPE_PROD:
+            n = args[k]
+            acc = vals[k]
+            for j in range(n):
+                acc *= stack[top - j]
+            top += 1 - n
+            stack[top] = acc
+        elif ops[k] == TAPE_SCALE:
+            stack[top] *= vals[k]
+        elif ops[k] == TAPE_POW:
+            stack[top] = cmath.pow(stack[top], vals[k])
+        elif ops[k] == TAPE_EXP:
+            stack[top] = cmath.exp(stack[top])
+        elif ops[k] == TAPE_LOG:
+            stack[top] = cmath.log(stack[top])
+        elif ops[k] == TAPE_SQRT:
+            stack[top] = cmath.sqrt(stack[top])
+        elif ops[k] == TAPE_ABS:
+            stack[top] = cmath.fabs(stack[top])
+
+    return stack[0]
@@ -0,0 +1,307 @@
+##@file matrix.pxi
+#@brief Arrays of linear expressions with numpy broadcasting
+#@details <pre> A MatrixExpr is an array of linear expressions of any shape. It is not stored as an array of
+# Expr objects but as one sparse matrix in compressed sparse row (CSR) format whose rows are the
+# elements of the flattened array and whose columns are variables, plus a dense array of constants:
+# element k is constant[k] + sum of data[j] * var(indices[j]) for j in range(indptr[k], indptr[k+1]),
+# where indices holds the SCIP_VAR pointers of the variables. The wrappers of the SCIP instance the variables
+# belong to are kept in _cache, so that toExpr() finds their interned Variable objects; the tables are detached
+# when the problem is freed, so the pointers are only dereferenced while _cache is still that of the model.
+#
+# All operations (broadcasting +, -, * with numbers and arrays, @ with numeric matrices, sum(axis=),
+# indexing) are linear maps of the rows, see _matrix_map(); they are carried out with vectorized numpy
+# operations on the CSR arrays. Comparing a MatrixExpr gives a MatrixExprCons, which
+# Model.addMatrixCons() turns into one linear constraint per element directly from the CSR arrays. </pre>
+
+cdef inline _matrix_shape(shape):
+    if _is_number(shape):
+        return (int(shape),)
+    return tuple(int(n) for n in shape)
+
+def _matrix_map(X, out, inn, coef, shape):
+    '''returns the MatrixExpr of the given shape whose element out[t] is the sum of coef[t] times element inn[t]
+    of X over all t with the same out[t]'''
+    nout = int(np.prod(shape, dtype=np.intp))
+    out = np.asarray(out, dtype=np.intp)
+    inn = np.asarray(inn, dtype=np.intp)
+    coef = np.asarray(coef, dtype=np.double)
+
+    # gather the nonzeros of the selected rows, grouped by the row they end up in
+    order = np.argsort(out, kind='stable')
+    out, inn, coef = out[order], inn[order], coef[order]
+    lengths = X.indptr[inn + 1] - X.indptr[inn]
+    pair = np.repeat(np.arange(len(inn), dtype=np.intp), lengths)
+    offsets = np.arange(pair.shape[0], dtype=np.intp) - np.repeat(np.cumsum(lengths) - lengths, lengths)
+    pos = X.indptr[inn][pair] + offsets
+
+    indptr = np.zeros(nout + 1, dtype=np.intp)
+    np.cumsum(np.bincount(out, weights=lengths, minlength=nout).astype(np.intp), out=indptr[1:])
+    constant = np.bincount(out, weights=coef * X.constant.ravel()[inn], minlength=nout)
+    return MatrixExpr(shape, indptr, X.indices[pos], X.data[pos] * coef[pair], constant.reshape(shape), X._cache)
+
+cdef _matrix_checkcache(X):
+    '''raises an exception if the variables of X belong to a freed problem'''
+    cdef _WrapperCache cache = X._cache
+    if X.indices.shape[0] > 0 and (cache is None or cache.scip == NULL):
+        raise ValueError("the variables of the MatrixExpr belong to a problem that was freed")
+
+def _matrix_stack(X, Y):
+    '''returns a flat MatrixExpr holding the elements of X followed by the elements of Y'''
+    if X._cache is not None and Y._cache is not None and X._cache is not Y._cache:
+        raise ValueError("cannot combine matrix expressions of different models")
+    return MatrixExpr((X.size + Y.size,), np.concatenate((X.indptr, Y.indptr[1:] + X.indptr[-1])),
+                      np.concatenate((X.indices, Y.indices)), np.concatenate((X.data, Y.data)),
+                      np.concatenate((X.constant.ravel(), Y.constant.ravel())),
+                      Y._cache if X._cache is None else X._cache)
+
+def _matrix_broadcast_index(shape, outshape):
+    '''returns the flat index of the element of an array of the given shape that is broadcast to each element
+    of an array of shape outshape'''
+    return np.broadcast_to(np.arange(int(np.prod(shape, dtype=np.intp)), dtype=np.intp).reshape(shape), outshape).ravel()
+
+def _matrix_from(other):
+    '''returns a Variable or linear Expr as MatrixExpr of shape (), other operands are returned unchanged'''
+    if isinstance(other, Expr):
+        if other.degree() > 1:
+            raise NotImplementedError("only linear expressions can be combined with a MatrixExpr")
+        terms = [(term, coef) for term, coef in other.terms.items() if term != CONST]
+        return MatrixExpr((), np.array([0, len(terms)], dtype=np.intp),
+                          np.array([term[0].ptr() for term, _ in terms], dtype=np.intp),
+                          np.array([coef for _, coef in terms], dtype=np.double),
+                          np.array(other[CONST], dtype=np.double),
+                          (<Variable>terms[0][0][0])._cache if terms else None)
+    if isinstance(other, GenExpr):
+        raise NotImplementedError("only linear expressions can be combined with a MatrixExpr")
+    return other
+
+class MatrixExpr:
+    '''Array of linear expressions, stored as sparse matrix in CSR format, see the description in matrix.pxi.'''
+
+    # let numpy hand binary operations with arrays to the reflected operators below
+    __array_ufunc__ = None
+
+    def __init__(self, shape, indptr, indices, data, constant=None, cache=None):
+        self.shape = _matrix_shape(shape)
+        self._cache = cache
+        self.indptr = np.ascontiguousarray(indptr, dtype=np.intp)
+        self.indices = np.ascontiguousarray(indices, dtype=np.intp)
+        self.data = np.ascontiguousarray(data, dtype=np.double)
+        if constant is None:
+            self.constant = np.zeros(self.shape)
+        else:
+            self.constant = np.array(np.broadcast_to(np.asarray(constant, dtype=np.double), self.shape))
+        if self.indptr.shape[0] != self.size + 1:
+            raise ValueError("indptr must have one entry more than the array has elements")
+
+    @property
+    def size(self):
+        return int(np.prod(self.shape, dtype=np.intp))
+
+    @property
+    def ndim(self):
+        return len(self.shape)
+
+    def __len__(self):
+        if self.ndim == 0:
+            raise TypeError("len() of a MatrixExpr of shape ()")
+        return self.shape[0]
+
+    def __iter__(self):
+        for i in range(len(self)):
+            yield self[i]
+
+    def __getitem__(self, key):
+        index = np.arange(self.size, dtype=np.intp).reshape(self.shape)[key]
+        return _matrix_map(self, np.arange(index.size), np.ravel(index), np.ones(index.size), np.shape(index))
+
+    def __repr__(self):
+        return 'MatrixExpr(shape=%s, nnz=%d)' % (self.shape, self.data.shape[0])
+
+    def __add__(self, other):
+        other = _matrix_from(other)
+        if isinstance(other, MatrixExpr):
+            shape = np.broadcast_shapes(self.shape, other.shape)
+            n = int(np.prod(shape, dtype=np.intp))
+            out = np.arange(n, dtype=np.intp)
+            inn = np.concatenate((_matrix_broadcast_index(self.shape, shape),
+                                  _matrix_broadcast_index(other.shape, shape) + self.size))
+            return _matrix_map(_matrix_stack(self, other), np.concatenate((out, out)), inn, np.ones(2 * n), shape)
+        values = np.asarray(other, dtype=np.double)
+        shape = np.broadcast_shapes(self.shape, values.shape)
+        result = _matrix_map(self, np.arange(int(np.prod(shape, dtype=np.intp))), _matrix_broadcast_index(self.shape, shape),
+                             np.ones(int(np.prod(shape, dtype=np.intp))), shape)
+        result.constant = result.constant + values
+        return result
+
+    def __radd__(self, other):
+        return self.__add__(other)
+
+    def __mul__(self, other):
+        other = _matrix_from(other)
+        if isinstance(other, MatrixExpr):
+            raise NotImplementedError("products of matrix expressions are not linear")
+        values = np.asarray(other, dtype=np.double)
+        shape = np.broadcast_shapes(self.shape, values.shape)
+        n = int(np.prod(shape, dtype=np.intp))
+        return _matrix_map(self, np.arange(n), _matrix_broadcast_index(self.shape, shape),
+                           np.broadcast_to(values, shape).ravel(), shape)
+
+    def __rmul__(self, other):
+        return self.__mul__(other)
+
+    def __truediv__(self, other):
+        if isinstance(_matrix_from(other), MatrixExpr):
+            raise NotImplementedError("cannot divide by a matrix expression")
+        return self.__mul__(1.0 / np.asarray(other, dtype=np.double))
+
+    def __neg__(self):
+        return self.__mul__(-1.0)
+
+    def __sub__(self, other):
+        other = _matrix_from(other)
+        if isinstance(other, MatrixExpr):
+            return self.__add__(-other)
+        return self.__add__(-np.asarray(other, dtype=np.double))
+
+    def __rsub__(self, other):
+        return self.__neg__().__add__(other)
+
+    def __matmul__(self, other):
+        ''' self @ other for a numeric matrix or vector other '''
+        if isinstance(_matrix_from(other), MatrixExpr):
+            raise NotImplementedError("products of matrix expressions are not linear")
+        B = np.asarray(other, dtype=np.double)
+        if self.ndim not in (1, 2) or B.ndim not in (1, 2):
+            raise ValueError("matmul is only supported for one- and two-dimensional operands")
+        m, n = (1, self.shape[0]) if self.ndim == 1 else self.shape
+        B2 = B.reshape(-1, 1) if B.ndim == 1 else B
+        if B2.shape[0] != n:
+            raise ValueError("matmul: mismatch in core dimension (%d != %d)" % (n, B2.shape[0]))
+        k = B2.shape[1]
+
+        # element (i,j) is the sum over l of element (i,l) times B[l,j]
+        l, j = np.nonzero(B2)
+        i = np.arange(m, dtype=np.intp)[:, None]
+        out = (i * k + j).ravel()
+        inn = (i * n + l).ravel()
+        coef = np.tile(B2[l, j], m)
+        shape = (m, k)[1 if self.ndim == 1 else 0 : 1 if B.ndim == 1 else 2]
+        return _matrix_map(self, out, inn, coef, shape)
+
+    def __rmatmul__(self, other):
+        ''' other @ self for a numeric matrix or vector other '''
+        A = np.asarray(other, dtype=np.double)
+        if self.ndim not in (1, 2) or A.ndim not in (1, 2):
+            raise ValueError("matmul is only supported for one- and two-dimensional operands")
+        n, k = (self.shape[0], 1) if self.ndim == 1 else self.shape
+        A2 = A.reshape(1, -1) if A.ndim == 1 else A
+        if A2.shape[1] != n:
+            raise ValueError("matmul: mismatch in core dimension (%d != %d)" % (A2.shape[1], n))
+        m = A2.shape[0]
+
+        # element (i,j) is the sum over l of A[i,l] times element (l,j)
+        i, l = np.nonzero(A2)
+        j = np.arange(k, dtype=np.intp)[:, None]
+        out = (i * k + j).ravel()
+        inn = (l * k + j).ravel()
+        coef = np.tile(A2[i, l], k)
+        shape = (m, k)[1 if A.ndim == 1 else 0 : 1 if self.ndim == 1 else 2]
+        return _matrix_map(self, out, inn, coef, shape)
+
+    def sum(self, axis=None):
+        '''sums the elements over the given axis or axes, or over all elements if axis is None'''
+        if axis is None:
+            axis = tuple(range(self.ndim))
+        elif _is_number(axis):
+            axis = (int(axis),)
+        axis = tuple(a % self.ndim for a in axis)
+        shape = tuple(n for a, n in enumerate(self.shape) if a not in axis)
+        out = np.arange(int(np.prod(shape, dtype=np.intp)), dtype=np.intp).reshape(shape)
+        out = np.broadcast_to(np.expand_dims(out, axis), self.shape).ravel()
+        return _matrix_map(self, out, np.arange(self.size), np.ones(self.size), shape)
+
+    def toExpr(self):
+        '''returns the single element of the array as Expr'''
+        cdef Variable var
+        cdef SCIP_VAR* scipvar
+        if self.size != 1:
+            raise ValueError("only a MatrixExpr with one element can be converted to an Expr")
+        _matrix_checkcache(self)
+        terms = {}
+        for k in range(self.indptr[0], self.indptr[1]):
+            scipvar = <SCIP_VAR*><size_t>self.indices[k]
+            var = Variable.create(scipvar, self._cache)
+            term = Term(var)
+            terms[term] = terms.get(term, 0.0) + self.data[k]
+        terms[CONST] = float(self.constant.ravel()[0])
+        return Expr(terms)
+
+    def __le__(self, other):
+        other = _matrix_from(other)
+        if isinstance(other, MatrixExpr):
+            return (self - other) <= 0.0
+        return MatrixExprCons(self, rhs=other)
+
+    def __ge__(self, other):
+        other = _matrix_from(other)
+        if isinstance(other, MatrixExpr):
+            return (self - other) >= 0.0
+        return MatrixExprCons(self, lhs=other)
+
+    def __eq__(self, other):
+        other = _matrix_from(other)
+        if isinstance(other, MatrixExpr):
+            return (self - other) == 0.0
+        return MatrixExprCons(self, lhs=other, rhs=other)
+
+    __hash__ = None
+
+
+class MatrixVariable(MatrixExpr):
+    '''Array of variables, created by Model.addMatrixVar(); indexing a single element gives its Variable.'''
+
+    def __init__(self, vars, ptrs, cache):
+        self.vars = vars
+        MatrixExpr.__init__(self, vars.shape, np.arange(vars.size + 1), ptrs, np.ones(vars.size), cache=cache)
+
+    def __getitem__(self, key):
+        vars = self.vars[key]
+        if isinstance(vars, Variable):
+            return vars
+        index = np.arange(self.size, dtype=np.intp).reshape(self.shape)[key]
+        return MatrixVariable(vars, self.indices[np.ravel(index)], self._cache)
+
+    def __repr__(self):
+        return 'MatrixVariable(shape=%s)' % (self.shape,)
+
+
+class MatrixExprCons:
+    '''Array of linear constraints lhs <= expr <= rhs, where lhs and rhs are broadcast to the shape of expr.'''
+
+    __array_ufunc__ = None
+
+    def __init__(self, expr, lhs=None, rhs=None):
+        assert not (lhs is None and rhs is None)
+        self.expr = expr
+        self.lhs = None if lhs is None else np.broadcast_to(np.asarray(lhs, dtype=np.double), expr.shape)
+        self.rhs = None if rhs is None else np.broadcast_to(np.asarray(rhs, dtype=np.double), expr.shape)
+
+    @property
+    def shape(self):
+        return self.expr.shape
+
+    def __le__(self, other):
+        if self.rhs is not None:
+            raise TypeError('MatrixExprCons already has upper bound')
+        return MatrixExprCons(self.expr, lhs=self.lhs, rhs=other)
+
+    def __ge__(self, other):
+        if self.lhs is not None:
+            raise TypeError('MatrixExprCons already has lower bound')
+        return MatrixExprCons(self.expr, lhs=other, rhs=self.rhs)
+
+    def __repr__(self):
+        return 'MatrixExprCons(%s, %s, %s)' % (self.expr, self.lhs, self.rhs)
+
+    def __bool__(self):
+        raise TypeError("Can't evaluate constraints as booleans; use parentheses for ranged constraints: lhs <= (expression <= rhs)")
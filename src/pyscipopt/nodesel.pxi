@@ -95,7 +95,7 @@ cdef int PyNodeselComp (SCIP* scip, SCIP_NODESEL* nodesel, SCIP_NODE* node1, SCI
   cdef SCIP_NODESELDATA* nodeseldata
   nodeseldata = SCIPnodeselGetData(nodesel)
   PyNodesel = <Nodesel>nodeseldata
-  n1 = Node.create(node1)
-  n2 = Node.create(node2)
+  n1 = Node.create(node1, _wrappersof(scip))
+  n2 = Node.create(node2, _wrappersof(scip))
   result = PyNodesel.nodecomp(n1, n2) #
   return result
@@ -152,7 +152,7 @@ cdef SCIP_RETCODE PyPropResProp (SCIP* scip, SCIP_PROP* prop, SCIP_VAR* infervar
     cdef SCIP_VAR* tmp
     tmp = infervar
     propdata = SCIPpropGetData(prop)
-    confvar = Variable.create(tmp)
+    confvar = Variable.create(tmp, _wrappersof(scip))
 
     #TODO: parse bdchgidx?
 
@@ -25,7 +25,10 @@ cdef class Relax:
         pass
         
     def relaxexec(self):
-        '''callls execution method of relaxation handler'''
+        '''callls execution method of relaxation handler
+
+        may return a dictionary with keys "result" and "lowerbound", the latter being the lower bound
+        on the objective value provided by the relaxation'''
         print("python error in relaxexec: this method needs to be implemented")
         return{}
 
@@ -73,6 +76,9 @@ cdef SCIP_RETCODE PyRelaxExec (SCIP* scip, SCIP_RELAX* relax, SCIP_Real* lowerbo
     cdef SCIP_RELAXDATA* relaxdata
     relaxdata = SCIPrelaxGetData(relax)
     PyRelax = <Relax>relaxdata
-    PyRelax.relaxexec()
+    result_dict = PyRelax.relaxexec()
+    if result_dict is not None:
+        lowerbound[0] = result_dict.get("lowerbound", lowerbound[0])
+        result[0] = result_dict.get("result", <SCIP_RESULT>result[0])
     return SCIP_OKAY
     
@@ -704,11 +704,14 @@ cdef extern from "scip/scip.h":
     SCIP_RETCODE SCIPaddPricedVar(SCIP* scip, SCIP_VAR* var, SCIP_Real score)
     SCIP_RETCODE SCIPreleaseVar(SCIP* scip, SCIP_VAR** var)
     SCIP_RETCODE SCIPtransformVar(SCIP* scip, SCIP_VAR* var, SCIP_VAR** transvar)
+    SCIP_RETCODE SCIPgetTransformedVar(SCIP* scip, SCIP_VAR* var, SCIP_VAR** transvar)
     SCIP_RETCODE SCIPaddVarLocks(SCIP* scip, SCIP_VAR* var, int nlocksdown, int nlocksup)
     SCIP_VAR** SCIPgetVars(SCIP* scip)
     SCIP_VAR** SCIPgetOrigVars(SCIP* scip)
+    SCIP_VAR* SCIPfindVar(SCIP* scip, const char* name)
     const char* SCIPvarGetName(SCIP_VAR* var)
     int SCIPvarGetIndex(SCIP_VAR* var)
+    int SCIPvarGetProbindex(SCIP_VAR* var)
     int SCIPgetNVars(SCIP* scip)
     int SCIPgetNOrigVars(SCIP* scip)
     SCIP_VARTYPE SCIPvarGetType(SCIP_VAR* var)
@@ -760,6 +763,7 @@ cdef extern from "scip/scip.h":
     SCIP_RETCODE SCIPtransformCons(SCIP* scip, SCIP_CONS* cons, SCIP_CONS** transcons)
     SCIP_RETCODE SCIPgetTransformedCons(SCIP* scip, SCIP_CONS* cons, SCIP_CONS** transcons)
     SCIP_CONS** SCIPgetConss(SCIP* scip)
+    SCIP_CONS* SCIPfindCons(SCIP* scip, const char* name)
     const char* SCIPconsGetName(SCIP_CONS* cons)
     int SCIPgetNConss(SCIP* scip)
     SCIP_Bool SCIPconsIsOriginal(SCIP_CONS* cons)
@@ -795,6 +799,7 @@ cdef extern from "scip/scip.h":
     SCIP_Real SCIPgetSolTransObj(SCIP* scip, SCIP_SOL* sol)
     SCIP_RETCODE SCIPcreateSol(SCIP* scip, SCIP_SOL** sol, SCIP_HEUR* heur)
     SCIP_RETCODE SCIPsetSolVal(SCIP* scip, SCIP_SOL* sol, SCIP_VAR* var, SCIP_Real val)
+    SCIP_RETCODE SCIPsetSolVals(SCIP* scip, SCIP_SOL* sol, int nvars, SCIP_VAR** vars, SCIP_Real* vals)
     SCIP_RETCODE SCIPtrySolFree(SCIP* scip, SCIP_SOL** sol, SCIP_Bool printreason, SCIP_Bool completely, SCIP_Bool checkbounds, SCIP_Bool checkintegrality, SCIP_Bool checklprows, SCIP_Bool* stored)
     SCIP_RETCODE SCIPtrySol(SCIP* scip, SCIP_SOL* sol, SCIP_Bool printreason, SCIP_Bool completely, SCIP_Bool checkbounds, SCIP_Bool checkintegrality, SCIP_Bool checklprows, SCIP_Bool* stored)
     SCIP_RETCODE SCIPfreeSol(SCIP* scip, SCIP_SOL** sol)
@@ -803,6 +808,7 @@ cdef extern from "scip/scip.h":
     SCIP_Real SCIPgetPrimalbound(SCIP* scip)
     SCIP_Real SCIPgetGap(SCIP* scip)
     int SCIPgetDepth(SCIP* scip)
+    int SCIPgetNRuns(SCIP* scip)
     SCIP_RETCODE SCIPaddSolFree(SCIP* scip, SCIP_SOL** sol, SCIP_Bool* stored)
     SCIP_RETCODE SCIPaddSol(SCIP* scip, SCIP_SOL* sol, SCIP_Bool* stored)
     SCIP_RETCODE SCIPreadSol(SCIP* scip, const char* filename)
@@ -811,6 +817,8 @@ cdef extern from "scip/scip.h":
     SCIP_RETCODE SCIPcheckSolOrig(SCIP* scip, SCIP_SOL* sol, SCIP_Bool* feasible, SCIP_Bool printreason, SCIP_Bool completely)
 
     SCIP_RETCODE SCIPsetRelaxSolVal(SCIP* scip, SCIP_RELAX* relax, SCIP_VAR* var, SCIP_Real val)
+    SCIP_RETCODE SCIPsetRelaxSolVals(SCIP* scip, SCIP_RELAX* relax, int nvars, SCIP_VAR** vars, SCIP_Real* vals, SCIP_Bool includeslp)
+    SCIP_RETCODE SCIPmarkRelaxSolValid(SCIP* scip, SCIP_RELAX* relax, SCIP_Bool includeslp)
 
     # Row Methods
     SCIP_RETCODE SCIPcreateRow(SCIP* scip, SCIP_ROW** row, const char* name, int len, SCIP_COL** cols, SCIP_Real* vals,
@@ -824,6 +832,7 @@ cdef extern from "scip/scip.h":
     SCIP_RETCODE SCIPcacheRowExtensions(SCIP* scip, SCIP_ROW* row)
     SCIP_RETCODE SCIPflushRowExtensions(SCIP* scip, SCIP_ROW* row)
     SCIP_RETCODE SCIPaddVarToRow(SCIP* scip, SCIP_ROW* row, SCIP_VAR* var, SCIP_Real val)
+    SCIP_RETCODE SCIPaddVarsToRow(SCIP* scip, SCIP_ROW* row, int nvars, SCIP_VAR** vars, SCIP_Real* vals)
     SCIP_RETCODE SCIPprintRow(SCIP* scip, SCIP_ROW* row, FILE* file)
 
     # Column Methods
@@ -1484,6 +1493,11 @@ cdef extern from "nlpi/pub_expr.h":
                                           SCIP_EXPRDATA_MONOMIAL** monomials,
                                           SCIP_Real constant,
                                           SCIP_Bool copymonomials)
+    SCIP_RETCODE SCIPexprCopyDeep(BMS_BLKMEM* blkmem,
+                                  SCIP_EXPR** targetexpr,
+                                  SCIP_EXPR* sourceexpr)
+    void SCIPexprFreeDeep(BMS_BLKMEM* blkmem,
+                          SCIP_EXPR** expr)
     SCIP_RETCODE SCIPexprtreeCreate(BMS_BLKMEM* blkmem,
                                     SCIP_EXPRTREE** tree,
                                     SCIP_EXPR* root,
@@ -1625,6 +1639,7 @@ cdef extern from "scip/pub_lp.h":
     SCIP_Real SCIProwGetRhs(SCIP_ROW* row)
     SCIP_Real SCIProwGetConstant(SCIP_ROW* row)
     int SCIProwGetLPPos(SCIP_ROW* row)
+    int SCIProwGetIndex(SCIP_ROW* row)
     SCIP_BASESTAT SCIProwGetBasisStatus(SCIP_ROW* row)
     SCIP_Bool SCIProwIsIntegral(SCIP_ROW* row)
     SCIP_Bool SCIProwIsLocal(SCIP_ROW* row)
@@ -1673,36 +1688,72 @@ cdef extern from "scip/scip_var.h":
 cdef class Expr:
     cdef public terms
 
+# tables of the interned Python wrappers of the objects of one SCIP instance, see _wrappersof()
+cdef class _WrapperCache:
+    cdef SCIP* scip
+    # run of the SCIP instance the nodes and rows in the tables belong to
+    cdef int run
+    cdef object cols
+    cdef object rows
+    cdef object nodes
+    # variables and constraints of the original problem are kept apart, since they survive freeTransform()
+    cdef object origvars
+    cdef object origconss
+    cdef object vars
+    cdef object conss
+    cdef object __weakref__
+
+    cdef _checkRun(self)
+    cdef _freeTransformed(self)
+    cdef _free(self)
+
 cdef class Event:
     cdef SCIP_EVENT* event
     # can be used to store problem data
     cdef public object data
+    # wrappers of the SCIP instance the event belongs to
+    cdef _WrapperCache _cache
+
     @staticmethod
-    cdef create(SCIP_EVENT* scip_event)
+    cdef create(SCIP_EVENT* scip_event, _WrapperCache cache)
 
 cdef class Column:
     cdef SCIP_COL* scip_col
     # can be used to store problem data
     cdef public object data
+    # make wrapper weak referentiable for interning
+    cdef object __weakref__
+    # wrappers of the SCIP instance the object belongs to
+    cdef _WrapperCache _cache
+    # unique number of the object in SCIP, to recognize a reused address
+    cdef long long _stamp
 
     @staticmethod
-    cdef create(SCIP_COL* scipcol)
+    cdef create(SCIP_COL* scipcol, _WrapperCache cache)
 
 cdef class Row:
     cdef SCIP_ROW* scip_row
     # can be used to store problem data
     cdef public object data
+    # make wrapper weak referentiable for interning
+    cdef object __weakref__
+    # wrappers of the SCIP instance the object belongs to
+    cdef _WrapperCache _cache
+    # unique number of the object in SCIP, to recognize a reused address
+    cdef long long _stamp
 
     @staticmethod
-    cdef create(SCIP_ROW* sciprow)
+    cdef create(SCIP_ROW* sciprow, _WrapperCache cache)
 
 cdef class NLRow:
     cdef SCIP_NLROW* scip_nlrow
     # can be used to store problem data
     cdef public object data
+    # wrappers of the SCIP instance the row belongs to
+    cdef _WrapperCache _cache
 
     @staticmethod
-    cdef create(SCIP_NLROW* scipnlrow)
+    cdef create(SCIP_NLROW* scipnlrow, _WrapperCache cache)
 
 cdef class Solution:
     cdef SCIP_SOL* sol
@@ -1715,39 +1766,60 @@ cdef class Solution:
 
 cdef class DomainChanges:
     cdef SCIP_DOMCHG* scip_domchg
+    cdef _WrapperCache _cache
 
     @staticmethod
-    cdef create(SCIP_DOMCHG* scip_domchg)
+    cdef create(SCIP_DOMCHG* scip_domchg, _WrapperCache cache)
 
 cdef class BoundChange:
     cdef SCIP_BOUNDCHG* scip_boundchg
+    cdef _WrapperCache _cache
 
     @staticmethod
-    cdef create(SCIP_BOUNDCHG* scip_boundchg)
+    cdef create(SCIP_BOUNDCHG* scip_boundchg, _WrapperCache cache)
 
 cdef class Node:
     cdef SCIP_NODE* scip_node
     # can be used to store problem data
     cdef public object data
+    # make wrapper weak referentiable for interning
+    cdef object __weakref__
+    # wrappers of the SCIP instance the object belongs to
+    cdef _WrapperCache _cache
+    # unique number of the object in SCIP, to recognize a reused address
+    cdef long long _stamp
 
     @staticmethod
-    cdef create(SCIP_NODE* scipnode)
+    cdef create(SCIP_NODE* scipnode, _WrapperCache cache)
 
 cdef class Variable(Expr):
     cdef SCIP_VAR* scip_var
     # can be used to store problem data
     cdef public object data
+    # make wrapper weak referentiable for interning
+    cdef object __weakref__
+    # wrappers of the SCIP instance the object belongs to
+    cdef _WrapperCache _cache
+    # unique number of the object in SCIP, to recognize a reused address
+    cdef long long _stamp
 
     @staticmethod
-    cdef create(SCIP_VAR* scipvar)
+    cdef create(SCIP_VAR* scipvar, _WrapperCache cache)
 
 cdef class Constraint:
     cdef SCIP_CONS* scip_cons
     # can be used to store problem data
     cdef public object data
+    # make wrapper weak referentiable for interning
+    cdef object __weakref__
+    # wrappers of the SCIP instance the object belongs to
+    cdef _WrapperCache _cache
+    # name and handler of the constraint, to recognize a reused address, since constraints have no unique number
+    cdef bytes _stampname
+    cdef SCIP_CONSHDLR* _stamphdlr
 
     @staticmethod
-    cdef create(SCIP_CONS* scipcons)
+    cdef create(SCIP_CONS* scipcons, _WrapperCache cache)
 
 cdef class Model:
     cdef SCIP* _scip
@@ -1763,6 +1835,17 @@ cdef class Model:
     cdef SCIP_Bool _freescip
     # map to store python variables
     cdef _modelvars
+    # interned wrappers of the objects of this SCIP instance
+    cdef _WrapperCache _wrappers
+    # scratch memory for temporary arrays that is reused between calls, see _getScratch()
+    cdef void* _scratch
+    cdef size_t _scratchsize
+    cdef SCIP_Bool _scratchused
 
     @staticmethod
     cdef create(SCIP* scip)
+
+    cdef void* _getScratch(self, size_t size) except NULL
+    cdef void _releaseScratch(self, void* ptr)
+    cdef int _addStagedLinearConss(self, list names, int nstaged, int* starts, SCIP_VAR** vars, SCIP_Real* coefs,
+                                   SCIP_Real* lhss, SCIP_Real* rhss, SCIP_Bool* flags, list pyconss) except -1
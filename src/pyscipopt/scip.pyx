@@ -1,18 +1,27 @@
 ##@file scip.pyx
 #@brief holding functions in python that reference the SCIP public functions included in scip.pxd
+import itertools
+import math
 import weakref
 from os.path import abspath
 from os.path import splitext
 import sys
 import warnings
 
+import numpy as np
+
 cimport cython
 from cpython cimport Py_INCREF, Py_DECREF
+from cpython.float cimport PyFloat_Check
+from cpython.long cimport PyLong_Check
 from cpython.pycapsule cimport PyCapsule_New, PyCapsule_IsValid, PyCapsule_GetPointer
-from libc.stdlib cimport malloc, free
+from libc.stdlib cimport malloc, realloc, free
+from libc cimport math as cmath
 from libc.stdio cimport fdopen
+from libc.string cimport strcmp
 
 include "expr.pxi"
+include "matrix.pxi"
 include "lp.pxi"
 include "benders.pxi"
 include "benderscut.pxi"
@@ -263,15 +272,104 @@ def PY_SCIP_CALL(SCIP_RETCODE rc):
     else:
         raise Exception('SCIP: unknown return code!')
 
+# Python wrappers of SCIP objects are interned per SCIP instance, such that repeated queries of the same SCIP object
+# (e.g., in callbacks) return the same Python object instead of allocating a new one. The tables only hold weak
+# references, so a wrapper is still freed as soon as it is not used anymore.
+# A wrapper may outlive its SCIP object, and SCIP reuses the addresses of freed objects. Hence, the tables are emptied
+# before SCIP frees the objects they refer to (freeTransform(), freeProb(), freeing the model, a new run), and a
+# wrapper found in a table is only returned if the unique number SCIP gave to its object, its _stamp, still matches.
+# Constraints have no such number, and SCIP frees transformed constraints itself, e.g., when presolving upgrades or
+# deletes them; a constraint wrapper is only returned if the name and handler of the constraint still match.
+_wrappercaches = weakref.WeakValueDictionary()
+
+cdef class _WrapperCache:
+    """tables of the interned wrappers of the objects of one SCIP instance, keyed by pointer"""
+
+    def __init__(self):
+        self.cols = weakref.WeakValueDictionary()
+        self.rows = weakref.WeakValueDictionary()
+        self.nodes = weakref.WeakValueDictionary()
+        self.origvars = weakref.WeakValueDictionary()
+        self.origconss = weakref.WeakValueDictionary()
+        self.vars = weakref.WeakValueDictionary()
+        self.conss = weakref.WeakValueDictionary()
+
+    cdef _checkRun(self):
+        """empties the tables of nodes, rows and columns if a new run has started, because SCIP frees them on restarts"""
+        cdef int run = SCIPgetNRuns(self.scip)
+        if run != self.run:
+            self.nodes.clear()
+            self.rows.clear()
+            self.cols.clear()
+            self.run = run
+
+    cdef _freeTransformed(self):
+        """removes the wrappers of the objects of the transformed problem, which is about to be freed"""
+        for table in (self.cols, self.rows, self.nodes, self.vars, self.conss):
+            table.clear()
+
+    cdef _free(self):
+        """removes all wrappers and detaches the tables from the SCIP instance, which is about to be freed"""
+        self._freeTransformed()
+        self.origvars.clear()
+        self.origconss.clear()
+        if _wrappercaches.get(<size_t>self.scip) is self:
+            del _wrappercaches[<size_t>self.scip]
+        self.scip = NULL
+
+cdef _WrapperCache _newwrappers(SCIP* scip):
+    """creates the tables of interned wrappers of a new SCIP instance"""
+    cdef _WrapperCache cache = _wrappercaches.get(<size_t>scip)
+    if cache is not None:
+        # the tables of a freed instance at the same address
+        cache._free()
+    cache = _WrapperCache()
+    cache.scip = scip
+    _wrappercaches[<size_t>scip] = cache
+    return cache
+
+cdef _WrapperCache _wrappersof(SCIP* scip):
+    """returns the tables of interned wrappers of a SCIP instance, e.g., in a callback"""
+    cdef _WrapperCache cache = _wrappercaches.get(<size_t>scip)
+    if cache is None:
+        cache = _newwrappers(scip)
+    return cache
+
+cdef SCIP_VAR* _findvar(SCIP* scip, name) except? NULL:
+    """finds a variable by its name; once the problem is transformed, SCIPfindVar() falls back to the original
+    variables, which are mapped to their transformed variables, or NULL if there is none"""
+    cdef SCIP_VAR* var = SCIPfindVar(scip, str_conversion(name))
+    if var != NULL and SCIPgetStage(scip) > SCIP_STAGE_PROBLEM and SCIPvarIsOriginal(var):
+        PY_SCIP_CALL(SCIPgetTransformedVar(scip, var, &var))
+    return var
+
+cdef SCIP_VARTYPE _vartype(vtype) except *:
+    """returns the SCIP variable type of the given type name, see Model.addVar()"""
+    if vtype in ['C', 'CONTINUOUS']:
+        return SCIP_VARTYPE_CONTINUOUS
+    elif vtype in ['B', 'BINARY']:
+        return SCIP_VARTYPE_BINARY
+    elif vtype in ['I', 'INTEGER']:
+        return SCIP_VARTYPE_INTEGER
+    elif vtype in ['M', 'IMPLINT']:
+        return SCIP_VARTYPE_IMPLINT
+    else:
+        raise Warning("unrecognized variable type")
+
+cdef inline bint _interning(_WrapperCache cache):
+    """whether wrappers are interned in the given tables"""
+    return cache is not None and cache.scip != NULL
+
 cdef class Event:
     """Base class holding a pointer to corresponding SCIP_EVENT"""
 
     @staticmethod
-    cdef create(SCIP_EVENT* scip_event):
+    cdef create(SCIP_EVENT* scip_event, _WrapperCache cache):
         if scip_event == NULL:
             raise Warning("cannot create Event with SCIP_EVENT* == NULL")
         event = Event()
         event.event = scip_event
+        event._cache = cache
         return event
 
     def getType(self):
@@ -292,17 +390,17 @@ cdef class Event:
     def getVar(self):
         """gets variable for a variable event (var added, var deleted, var fixed, objective value or domain change, domain hole added or removed)"""
         cdef SCIP_VAR* var = SCIPeventGetVar(self.event)
-        return Variable.create(var)
+        return Variable.create(var, self._cache)
 
     def getNode(self):
         """gets node for a node or LP event"""
         cdef SCIP_NODE* node = SCIPeventGetNode(self.event)
-        return Node.create(node)
+        return Node.create(node, self._cache)
 
     def getRow(self):
         """gets row for a row event"""
         cdef SCIP_ROW* row = SCIPeventGetRow(self.event)
-        return Row.create(row)
+        return Row.create(row, self._cache)
 
     def __hash__(self):
         return hash(<size_t>self.event)
@@ -315,11 +413,21 @@ cdef class Column:
     """Base class holding a pointer to corresponding SCIP_COL"""
 
     @staticmethod
-    cdef create(SCIP_COL* scipcol):
+    cdef create(SCIP_COL* scipcol, _WrapperCache cache):
         if scipcol == NULL:
             raise Warning("cannot create Column with SCIP_COL* == NULL")
-        col = Column()
-        col.scip_col = scipcol
+        cdef Column col = None
+        cdef long long stamp = SCIPcolGetIndex(scipcol)
+        if _interning(cache):
+            cache._checkRun()
+            col = cache.cols.get(<size_t>scipcol)
+        if col is None or col._stamp != stamp:
+            col = Column()
+            col.scip_col = scipcol
+            col._cache = cache
+            col._stamp = stamp
+            if _interning(cache):
+                cache.cols[<size_t>scipcol] = col
         return col
     
     def getIndex(self):
@@ -350,7 +458,7 @@ cdef class Column:
     def getVar(self):
         """gets variable this column represents"""
         cdef SCIP_VAR* var = SCIPcolGetVar(self.scip_col)
-        return Variable.create(var)
+        return Variable.create(var, self._cache)
 
     def getPrimsol(self):
         """gets the primal LP solution of a column"""
@@ -375,11 +483,21 @@ cdef class Row:
     """Base class holding a pointer to corresponding SCIP_ROW"""
 
     @staticmethod
-    cdef create(SCIP_ROW* sciprow):
+    cdef create(SCIP_ROW* sciprow, _WrapperCache cache):
         if sciprow == NULL:
             raise Warning("cannot create Row with SCIP_ROW* == NULL")
-        row = Row()
-        row.scip_row = sciprow
+        cdef Row row = None
+        cdef long long stamp = SCIProwGetIndex(sciprow)
+        if _interning(cache):
+            cache._checkRun()
+            row = cache.rows.get(<size_t>sciprow)
+        if row is None or row._stamp != stamp:
+            row = Row()
+            row.scip_row = sciprow
+            row._cache = cache
+            row._stamp = stamp
+            if _interning(cache):
+                cache.rows[<size_t>sciprow] = row
         return row
 
     property name:
@@ -445,7 +563,7 @@ cdef class Row:
     def getCols(self):
         """gets list with columns of nonzero entries"""
         cdef SCIP_COL** cols = SCIProwGetCols(self.scip_row)
-        return [Column.create(cols[i]) for i in range(self.getNNonz())]
+        return [Column.create(cols[i], self._cache) for i in range(self.getNNonz())]
 
     def getVals(self):
         """gets list with coefficients of nonzero entries"""
@@ -463,11 +581,12 @@ cdef class NLRow:
     """Base class holding a pointer to corresponding SCIP_NLROW"""
 
     @staticmethod
-    cdef create(SCIP_NLROW* scipnlrow):
+    cdef create(SCIP_NLROW* scipnlrow, _WrapperCache cache):
         if scipnlrow == NULL:
             raise Warning("cannot create NLRow with SCIP_NLROW* == NULL")
         nlrow = NLRow()
         nlrow.scip_nlrow = scipnlrow
+        nlrow._cache = cache
         return nlrow
 
     property name:
@@ -484,7 +603,7 @@ cdef class NLRow:
         cdef SCIP_VAR** linvars = SCIPnlrowGetLinearVars(self.scip_nlrow)
         cdef SCIP_Real* lincoefs = SCIPnlrowGetLinearCoefs(self.scip_nlrow)
         cdef int nlinvars = SCIPnlrowGetNLinearVars(self.scip_nlrow)
-        return [(Variable.create(linvars[i]), lincoefs[i]) for i in range(nlinvars)]
+        return [(Variable.create(linvars[i], self._cache), lincoefs[i]) for i in range(nlinvars)]
 
     def getQuadraticTerms(self):
         """returns a list of tuples (var1, var2, coef) representing the quadratic part of a nonlinear row"""
@@ -497,8 +616,8 @@ cdef class NLRow:
 
         quadterms = []
         for i in range(nquadelems):
-            x = Variable.create(quadvars[quadelems[i].idx1])
-            y = Variable.create(quadvars[quadelems[i].idx2])
+            x = Variable.create(quadvars[quadelems[i].idx1], self._cache)
+            y = Variable.create(quadvars[quadelems[i].idx2], self._cache)
             coef = quadelems[i].coef
             quadterms.append((x,y,coef))
         return quadterms
@@ -565,11 +684,12 @@ cdef class BoundChange:
     """Bound change."""
 
     @staticmethod
-    cdef create(SCIP_BOUNDCHG* scip_boundchg):
+    cdef create(SCIP_BOUNDCHG* scip_boundchg, _WrapperCache cache):
         if scip_boundchg == NULL:
             raise Warning("cannot create BoundChange with SCIP_BOUNDCHG* == NULL")
         boundchg = BoundChange()
         boundchg.scip_boundchg = scip_boundchg
+        boundchg._cache = cache
         return boundchg
 
     def getNewBound(self):
@@ -578,7 +698,7 @@ cdef class BoundChange:
 
     def getVar(self):
         """Returns the variable of the bound change."""
-        return Variable.create(SCIPboundchgGetVar(self.scip_boundchg))
+        return Variable.create(SCIPboundchgGetVar(self.scip_boundchg), self._cache)
 
     def getBoundchgtype(self):
         """Returns the bound change type of the bound change."""
@@ -601,33 +721,46 @@ cdef class DomainChanges:
     """Set of domain changes."""
 
     @staticmethod
-    cdef create(SCIP_DOMCHG* scip_domchg):
+    cdef create(SCIP_DOMCHG* scip_domchg, _WrapperCache cache):
         if scip_domchg == NULL:
             raise Warning("cannot create DomainChanges with SCIP_DOMCHG* == NULL")
         domchg = DomainChanges()
         domchg.scip_domchg = scip_domchg
+        domchg._cache = cache
         return domchg
 
     def getBoundchgs(self):
         """Returns the bound changes in the domain change."""
         nboundchgs = SCIPdomchgGetNBoundchgs(self.scip_domchg)
-        return [BoundChange.create(SCIPdomchgGetBoundchg(self.scip_domchg, i))
+        return [BoundChange.create(SCIPdomchgGetBoundchg(self.scip_domchg, i), self._cache)
                 for i in range(nboundchgs)]
 
 cdef class Node:
     """Base class holding a pointer to corresponding SCIP_NODE"""
 
     @staticmethod
-    cdef create(SCIP_NODE* scipnode):
+    cdef create(SCIP_NODE* scipnode, _WrapperCache cache):
         if scipnode == NULL:
             return None
-        node = Node()
-        node.scip_node = scipnode
+        cdef Node node = None
+        cdef long long stamp = SCIPnodeGetNumber(scipnode)
+        # probing nodes are freed on backtracking and may share their number, so they are not interned
+        cdef bint intern = _interning(cache) and SCIPnodeGetType(scipnode) != SCIP_NODETYPE_PROBINGNODE
+        if intern:
+            cache._checkRun()
+            node = cache.nodes.get(<size_t>scipnode)
+        if node is None or node._stamp != stamp:
+            node = Node()
+            node.scip_node = scipnode
+            node._cache = cache
+            node._stamp = stamp
+            if intern:
+                cache.nodes[<size_t>scipnode] = node
         return node
 
     def getParent(self):
         """Retrieve parent node (or None if the node has no parent node)."""
-        return Node.create(SCIPnodeGetParent(self.scip_node))
+        return Node.create(SCIPnodeGetParent(self.scip_node), self._cache)
 
     def getNumber(self):
         """Retrieve number of node."""
@@ -658,7 +791,7 @@ cdef class Node:
         cdef int nconss
         SCIPnodeGetAddedConss(self.scip_node, addedconss, &nconss, addedconsssize)
         assert nconss == addedconsssize
-        constraints = [Constraint.create(addedconss[i]) for i in range(nconss)]
+        constraints = [Constraint.create(addedconss[i], self._cache) for i in range(nconss)]
         free(addedconss)
         return constraints
 
@@ -701,7 +834,7 @@ cdef class Node:
         SCIPnodeGetParentBranchings(self.scip_node, branchvars, branchbounds,
                                     boundtypes, &nbranchvars, nbranchvars)
 
-        py_variables = [Variable.create(branchvars[i]) for i in range(nbranchvars)]
+        py_variables = [Variable.create(branchvars[i], self._cache) for i in range(nbranchvars)]
         py_branchbounds = [branchbounds[i] for i in range(nbranchvars)]
         py_boundtypes = [boundtypes[i] for i in range(nbranchvars)]
 
@@ -723,7 +856,65 @@ cdef class Node:
         cdef SCIP_DOMCHG* domchg = SCIPnodeGetDomchg(self.scip_node)
         if domchg == NULL:
             return None
-        return DomainChanges.create(domchg)
+        return DomainChanges.create(domchg, self._cache)
+
+    def getPathBoundChanges(self, propagated=False):
+        """Retrieve the bound changes on the path from the root to this node as arrays, ordered by depth.
+
+        :param propagated: also include the bound changes due to constraint propagation and propagation,
+                           see getNDomchg(), instead of only the branching decisions (Default value = False)
+        :return: tuple (varindices, newbounds, boundtypes, depths) of numpy arrays, where varindices refer to the
+                 order of Model.getVars(transformed=True), or are -1 for variables that are not active anymore,
+                 e.g., fixed or aggregated after the change, and boundtypes holds SCIP_BOUNDTYPE values
+
+        """
+        cdef int depth = SCIPnodeGetDepth(self.scip_node)
+        cdef SCIP_NODE** path = <SCIP_NODE**> malloc((depth + 1) * sizeof(SCIP_NODE*))
+        cdef SCIP_NODE* node = self.scip_node
+        cdef SCIP_DOMCHG* domchg
+        cdef SCIP_BOUNDCHG* boundchg
+        cdef int[::1] _varindices
+        cdef double[::1] _newbounds
+        cdef int[::1] _boundtypes
+        cdef int[::1] _depths
+        cdef int nchanges = 0
+        cdef int pass_, d, j
+        cdef int pos
+
+        try:
+            # collect the ancestors, such that path[d] is the ancestor at depth d
+            for d in range(depth, -1, -1):
+                path[d] = node
+                node = SCIPnodeGetParent(node)
+
+            # the first pass counts the bound changes, the second one fills the arrays
+            for pass_ in range(2):
+                if pass_ == 1:
+                    varindices = np.empty(nchanges, dtype=np.intc)
+                    newbounds = np.empty(nchanges, dtype=np.double)
+                    boundtypes = np.empty(nchanges, dtype=np.intc)
+                    depths = np.empty(nchanges, dtype=np.intc)
+                    _varindices, _newbounds, _boundtypes, _depths = varindices, newbounds, boundtypes, depths
+                pos = 0
+                for d in range(depth + 1):
+                    domchg = SCIPnodeGetDomchg(path[d])
+                    if domchg == NULL:
+                        continue
+                    for j in range(SCIPdomchgGetNBoundchgs(domchg)):
+                        boundchg = SCIPdomchgGetBoundchg(domchg, j)
+                        if not propagated and SCIPboundchgGetBoundchgtype(boundchg) != SCIP_BOUNDCHGTYPE_BRANCHING:
+                            continue
+                        if pass_ == 1:
+                            _varindices[pos] = SCIPvarGetProbindex(SCIPboundchgGetVar(boundchg))
+                            _newbounds[pos] = SCIPboundchgGetNewbound(boundchg)
+                            _boundtypes[pos] = SCIPboundchgGetBoundtype(boundchg)
+                            _depths[pos] = d
+                        pos += 1
+                nchanges = pos
+        finally:
+            free(path)
+
+        return varindices, newbounds, boundtypes, depths
 
     def __hash__(self):
         return hash(<size_t>self.scip_node)
@@ -736,14 +927,31 @@ cdef class Variable(Expr):
     """Is a linear expression and has SCIP_VAR*"""
 
     @staticmethod
-    cdef create(SCIP_VAR* scipvar):
+    cdef create(SCIP_VAR* scipvar, _WrapperCache cache):
         if scipvar == NULL:
             raise Warning("cannot create Variable with SCIP_VAR* == NULL")
-        var = Variable()
-        var.scip_var = scipvar
-        Expr.__init__(var, {Term(var) : 1.0})
+        cdef Variable var = None
+        cdef long long stamp = SCIPvarGetIndex(scipvar)
+        table = None
+        if _interning(cache):
+            table = cache.origvars if SCIPvarIsOriginal(scipvar) else cache.vars
+            var = table.get(<size_t>scipvar)
+        if var is None or var._stamp != stamp:
+            # the terms of the variable are only created when it takes part in arithmetic, see terms below
+            var = Variable.__new__(Variable)
+            var.scip_var = scipvar
+            var._cache = cache
+            var._stamp = stamp
+            if table is not None:
+                table[<size_t>scipvar] = var
         return var
 
+    property terms:
+        def __get__(self):
+            return _termsof(self)
+        def __set__(self, terms):
+            (<Expr>self).terms = terms
+
     property name:
         def __get__(self):
             cname = bytes( SCIPvarGetName(self.scip_var) )
@@ -785,7 +993,7 @@ cdef class Variable(Expr):
         """Retrieve column of COLUMN variable"""
         cdef SCIP_COL* scip_col
         scip_col = SCIPvarGetCol(self.scip_var)
-        return Column.create(scip_col)
+        return Column.create(scip_col, self._cache)
 
     def getLbOriginal(self):
         """Retrieve original lower bound of variable"""
@@ -823,11 +1031,23 @@ cdef class Constraint:
     """Base class holding a pointer to corresponding SCIP_CONS"""
 
     @staticmethod
-    cdef create(SCIP_CONS* scipcons):
+    cdef create(SCIP_CONS* scipcons, _WrapperCache cache):
         if scipcons == NULL:
             raise Warning("cannot create Constraint with SCIP_CONS* == NULL")
-        cons = Constraint()
-        cons.scip_cons = scipcons
+        cdef Constraint cons = None
+        table = None
+        if _interning(cache):
+            table = cache.origconss if SCIPconsIsOriginal(scipcons) else cache.conss
+            cons = table.get(<size_t>scipcons)
+        if cons is None or cons._stamphdlr != SCIPconsGetHdlr(scipcons) or \
+           strcmp(SCIPconsGetName(scipcons), cons._stampname) != 0:
+            cons = Constraint()
+            cons.scip_cons = scipcons
+            cons._cache = cache
+            cons._stampname = SCIPconsGetName(scipcons)
+            cons._stamphdlr = SCIPconsGetHdlr(scipcons)
+            if table is not None:
+                table[<size_t>scipcons] = cons
         return cons
 
     property name:
@@ -916,6 +1136,9 @@ cdef void relayErrorMessage(void *messagehdlr, FILE *file, const char *msg):
 ##
 #@anchor Model
 ##
+# maximal size in bytes of the scratch memory that a model keeps between calls, see Model._getScratch()
+cdef size_t _MAXSCRATCHSIZE = 1 << 20
+
 cdef class Model:
     """Main class holding a pointer to SCIP for managing most interactions"""
 
@@ -945,12 +1168,14 @@ cdef class Model:
             self._freescip = False
         elif sourceModel is None:
             PY_SCIP_CALL(SCIPcreate(&self._scip))
+            self._wrappers = _newwrappers(self._scip)
             self._bestSol = None
             if defaultPlugins:
                 self.includeDefaultPlugins()
             self.createProbBasic(problemName)
         else:
             PY_SCIP_CALL(SCIPcreate(&self._scip))
+            self._wrappers = _newwrappers(self._scip)
             self._bestSol = <Solution> sourceModel._bestSol
             n = str_conversion(problemName)
             if origcopy:
@@ -962,7 +1187,10 @@ cdef class Model:
         # call C function directly, because we can no longer call this object's methods, according to
         # http://docs.cython.org/src/reference/extension_types.html#finalization-dealloc
         if self._scip is not NULL and self._freescip and PY_SCIP_CALL:
+           if self._wrappers is not None:
+               self._wrappers._free()
            PY_SCIP_CALL( SCIPfree(&self._scip) )
+        free(self._scratch)
 
     def __hash__(self):
         return hash(<size_t>self._scip)
@@ -979,9 +1207,45 @@ cdef class Model:
             raise Warning("cannot create Model with SCIP* == NULL")
         model = Model(createscip=False)
         model._scip = scip
+        model._wrappers = _wrappersof(scip)
         model._bestSol = Solution.create(scip, SCIPgetBestSol(scip))
         return model
 
+    cdef void* _getScratch(self, size_t size) except NULL:
+        """returns temporary memory of at least the given size, which has to be given back with _releaseScratch();
+        the memory is kept and reused by later calls unless it exceeds _MAXSCRATCHSIZE, only nested requests fall
+        back to malloc()"""
+        cdef void* ptr
+        if size == 0:
+            size = 1
+        if self._scratchused:
+            ptr = malloc(size)
+        else:
+            if size > self._scratchsize:
+                free(self._scratch)
+                self._scratchsize = max(size, 2 * self._scratchsize)
+                self._scratch = malloc(self._scratchsize)
+                if self._scratch == NULL:
+                    self._scratchsize = 0
+            ptr = self._scratch
+            if ptr != NULL:
+                self._scratchused = True
+        if ptr == NULL:
+            raise MemoryError()
+        return ptr
+
+    cdef void _releaseScratch(self, void* ptr):
+        """gives back memory obtained from _getScratch()"""
+        if ptr == self._scratch:
+            self._scratchused = False
+            # the memory of a single large request is not kept for the lifetime of the model
+            if self._scratchsize > _MAXSCRATCHSIZE:
+                free(self._scratch)
+                self._scratch = NULL
+                self._scratchsize = 0
+        else:
+            free(ptr)
+
     @property
     def _freescip(self):
         """Return whether the underlying Scip pointer gets deallocted when the current
@@ -996,6 +1260,11 @@ cdef class Model:
         """
         self._freescip = val
 
+    @property
+    def _scratchused(self):
+        """Return whether the scratch memory of _getScratch() is currently handed out."""
+        return self._scratchused
+
     @cython.always_allow_keywords(True)
     @staticmethod
     def from_ptr(capsule, take_ownership):
@@ -1036,14 +1305,19 @@ cdef class Model:
 
         """
         n = str_conversion(problemName)
+        self._wrappers._free()
+        self._wrappers = _newwrappers(self._scip)
         PY_SCIP_CALL(SCIPcreateProbBasic(self._scip, n))
 
     def freeProb(self):
         """Frees problem and solution process data"""
+        self._wrappers._free()
+        self._wrappers = _newwrappers(self._scip)
         PY_SCIP_CALL(SCIPfreeProb(self._scip))
 
     def freeTransform(self):
         """Frees all solution process data including presolving and transformed problem, only original problem is kept"""
+        self._wrappers._freeTransformed()
         PY_SCIP_CALL(SCIPfreeTransform(self._scip))
 
     def version(self):
@@ -1104,7 +1378,7 @@ cdef class Model:
 
     def getCurrentNode(self):
         """Retrieve current node."""
-        return Node.create(SCIPgetCurrentNode(self._scip))
+        return Node.create(SCIPgetCurrentNode(self._scip), self._wrappers)
 
     def getGap(self):
         """Retrieve the gap, i.e. |(primalbound - dualbound)/min(|primalbound|,|dualbound|)|."""
@@ -1240,6 +1514,9 @@ cdef class Model:
         cdef SCIP_VAR** _vars
         cdef int _nvars
 
+        if isinstance(coeffs, MatrixExpr):
+            coeffs = coeffs.toExpr()
+
         # turn the constant value into an Expr instance for further processing
         if not isinstance(coeffs, Expr):
             assert(_is_number(coeffs)), "given coefficients are neither Expr or number but %s" % coeffs.__class__.__name__
@@ -1271,6 +1548,56 @@ cdef class Model:
         else:
             raise Warning("unrecognized optimization sense: %s" % sense)
 
+    def setQuadObjective(self, Q_coo, c=None, vars=None, sense='minimize', clear=True, name='quadobj'):
+        """Establish the quadratic objective function x'Qx + c'x, given by arrays.
+
+        The linear part becomes the objective coefficients. Since SCIP only supports linear objectives, the
+        quadratic part is represented by an auxiliary variable, which is linked to it by a quadratic constraint
+        created directly from the arrays, see addQuadCons().
+
+        :param Q_coo: quadratic part as tuple (row, col, data) in coordinate format, see addQuadCons()
+        :param c: coefficients of the linear part, one per variable (Default value = None)
+        :param vars: variables x the indices refer to; None uses the variables in the order of getVars() (Default value = None)
+        :param sense: the objective sense (Default value = 'minimize')
+        :param clear: set all other variables objective coefficient to zero (Default value = True)
+        :param name: name of the auxiliary variable and of its constraint (Default value = 'quadobj')
+        :return: the auxiliary variable, or None if the quadratic part is empty
+
+        """
+        if sense not in ("minimize", "maximize"):
+            raise Warning("unrecognized optimization sense: %s" % sense)
+        if vars is None:
+            vars = self.getVars()
+        nvars = len(vars)
+        row, col, data = _coo_arrays(Q_coo)
+
+        if clear:
+            self.setObjective(0.0, sense=sense, clear=True)
+        elif sense == "minimize":
+            self.setMinimize()
+        else:
+            self.setMaximize()
+
+        if c is not None:
+            c = np.ascontiguousarray(c, dtype=np.double)
+            if c.shape[0] != nvars:
+                raise ValueError("expected %d linear coefficients, got %d" % (nvars, c.shape[0]))
+            for i in np.flatnonzero(c):
+                PY_SCIP_CALL(SCIPchgVarObj(self._scip, (<Variable?>vars[i]).scip_var, c[i]))
+
+        if data.shape[0] == 0:
+            return None
+
+        # the auxiliary variable is bounded by the quadratic part in the direction of optimization
+        aux = self.addVar(name, vtype='C', lb=None, ub=None, obj=1.0)
+        auxcoefs = np.zeros(nvars + 1)
+        auxcoefs[nvars] = -1.0
+        if sense == "minimize":
+            self.addQuadCons((row, col, data), auxcoefs, rhs=0.0, vars=list(vars) + [aux], name=name)
+        else:
+            self.addQuadCons((row, col, data), auxcoefs, lhs=0.0, vars=list(vars) + [aux], name=name)
+        return aux
+
     def getObjective(self):
         """Retrieve objective function as Expr"""
         variables = self.getVars()
@@ -1401,6 +1728,7 @@ cdef class Model:
 
         """
         cdef SCIP_VAR* scip_var
+        cdef SCIP_VARTYPE _vtype
 
         # replace empty name with generic one
         if name == '':
@@ -1413,28 +1741,20 @@ cdef class Model:
         if ub is None:
             ub = SCIPinfinity(self._scip)
 
-        vtype = vtype.upper()
-        if vtype in ['C', 'CONTINUOUS']:
-            PY_SCIP_CALL(SCIPcreateVarBasic(self._scip, &scip_var, cname, lb, ub, obj, SCIP_VARTYPE_CONTINUOUS))
-        elif vtype in ['B', 'BINARY']:
+        _vtype = _vartype(vtype.upper())
+        if _vtype == SCIP_VARTYPE_BINARY:
             if ub > 1.0:
                 ub = 1.0
             if lb < 0.0:
                 lb = 0.0
-            PY_SCIP_CALL(SCIPcreateVarBasic(self._scip, &scip_var, cname, lb, ub, obj, SCIP_VARTYPE_BINARY))
-        elif vtype in ['I', 'INTEGER']:
-            PY_SCIP_CALL(SCIPcreateVarBasic(self._scip, &scip_var, cname, lb, ub, obj, SCIP_VARTYPE_INTEGER))
-        elif vtype in ['M', 'IMPLINT']:
-            PY_SCIP_CALL(SCIPcreateVarBasic(self._scip, &scip_var, cname, lb, ub, obj, SCIP_VARTYPE_IMPLINT))
-        else:
-            raise Warning("unrecognized variable type")
+        PY_SCIP_CALL(SCIPcreateVarBasic(self._scip, &scip_var, cname, lb, ub, obj, _vtype))
 
         if pricedVar:
             PY_SCIP_CALL(SCIPaddPricedVar(self._scip, scip_var, 1.0))
         else:
             PY_SCIP_CALL(SCIPaddVar(self._scip, scip_var))
 
-        pyVar = Variable.create(scip_var)
+        pyVar = Variable.create(scip_var, self._wrappers)
 
         # store variable in the model to avoid creating new python variable objects in getVars()
         assert not pyVar.ptr() in self._modelvars
@@ -1445,6 +1765,163 @@ cdef class Model:
         PY_SCIP_CALL(SCIPreleaseVar(self._scip, &scip_var))
         return pyVar
 
+    def addMatrixVar(self, shape, vtype='C', lb=0.0, ub=None, obj=0.0, name=''):
+        """Create an array of variables, which can be used in vectorized linear expressions, see MatrixExpr.
+
+        :param shape: shape of the array, an integer or a tuple of integers
+        :param vtype: type of the variables: 'C' continuous, 'I' integer, 'B' binary, and 'M' implicit integer (Default value = 'C')
+        :param lb: lower bounds, a number or an array broadcastable to shape, use None for -infinity (Default value = 0.0)
+        :param ub: upper bounds, a number or an array broadcastable to shape, use None for +infinity (Default value = None)
+        :param obj: objective coefficients, a number or an array broadcastable to shape (Default value = 0.0)
+        :param name: prefix of the names of the variables, to which the index is appended; generic names if empty (Default value = '')
+        :return: MatrixVariable of the given shape
+
+        """
+        cdef SCIP_VAR* scip_var
+        cdef SCIP_VARTYPE _vtype
+        cdef SCIP_Real infinity = SCIPinfinity(self._scip)
+        cdef double[::1] _lbs
+        cdef double[::1] _ubs
+        cdef double[::1] _objs
+        cdef Py_ssize_t[::1] _ptrs
+        cdef Py_ssize_t n
+        cdef Py_ssize_t k
+
+        shape = _matrix_shape(shape)
+        n = int(np.prod(shape, dtype=np.intp))
+        _lbs = np.ascontiguousarray(np.broadcast_to(np.asarray(-infinity if lb is None else lb, dtype=np.double), shape)).ravel()
+        _ubs = np.ascontiguousarray(np.broadcast_to(np.asarray(infinity if ub is None else ub, dtype=np.double), shape)).ravel()
+        _objs = np.ascontiguousarray(np.broadcast_to(np.asarray(obj, dtype=np.double), shape)).ravel()
+
+        _vtype = _vartype(vtype.upper())
+
+        vars = np.empty(n, dtype=object)
+        ptrs = np.empty(n, dtype=np.intp)
+        _ptrs = ptrs
+        for k, index in enumerate(np.ndindex(*shape)):
+            if name == '':
+                cname = str_conversion('x'+str(SCIPgetNVars(self._scip)+1))
+            else:
+                cname = str_conversion(name + ''.join('_%d' % i for i in index))
+            if _vtype == SCIP_VARTYPE_BINARY:
+                PY_SCIP_CALL(SCIPcreateVarBasic(self._scip, &scip_var, cname, max(_lbs[k], 0.0), min(_ubs[k], 1.0), _objs[k], _vtype))
+            else:
+                PY_SCIP_CALL(SCIPcreateVarBasic(self._scip, &scip_var, cname, _lbs[k], _ubs[k], _objs[k], _vtype))
+            PY_SCIP_CALL(SCIPaddVar(self._scip, scip_var))
+
+            pyVar = Variable.create(scip_var, self._wrappers)
+            self._modelvars[pyVar.ptr()] = pyVar
+            SCIPvarSetData(scip_var, <SCIP_VARDATA*>pyVar)
+            PY_SCIP_CALL(SCIPreleaseVar(self._scip, &scip_var))
+            vars[k] = pyVar
+            _ptrs[k] = <Py_ssize_t>(<Variable>pyVar).scip_var
+
+        return MatrixVariable(vars.reshape(shape), ptrs, self._wrappers)
+
+    def addPricedVars(self, obj, lb, ub, csc_matrix, conss, vtype='C', names=None):
+        """Create several priced variables and add them to linear constraints, e.g., during pricing.
+
+        The coefficients of the new variables are given as a sparse matrix in compressed sparse column (CSC)
+        format, with one column per new variable and one row per constraint in conss.
+
+        :param obj: objective coefficients of the new variables, either a scalar or an array of length ncols
+        :param lb: lower bounds of the new variables, either a scalar or an array of length ncols; use None or -inf for -infinity
+        :param ub: upper bounds of the new variables, either a scalar or an array of length ncols; use None or inf for +infinity
+        :param csc_matrix: coefficient matrix, either an object with attributes indptr, indices and data
+                           (e.g., a scipy.sparse.csc_matrix) or a tuple (indptr, indices, data)
+        :param conss: sequence of linear constraints the row indices of csc_matrix refer to
+        :param vtype: type of all new variables, see addVar() (Default value = 'C')
+        :param names: sequence of variable names, generic names if None (Default value = None)
+        :return: list of the new variables
+
+        """
+        cdef SCIP_CONSHDLR* linconshdlr = SCIPfindConshdlr(self._scip, "linear")
+        cdef SCIP_CONS** _conss
+        cdef SCIP_CONS* transcons
+        cdef SCIP_VAR* scip_var
+        cdef SCIP_VARTYPE _vtype
+        cdef SCIP_Real infinity = SCIPinfinity(self._scip)
+        cdef SCIP_Real varlb
+        cdef SCIP_Real varub
+        cdef int nconss = len(conss)
+        cdef int ncols
+        cdef int i
+        cdef int j
+        cdef int k
+
+        if hasattr(csc_matrix, "indptr"):
+            indptr, indices, data = csc_matrix.indptr, csc_matrix.indices, csc_matrix.data
+        else:
+            indptr, indices, data = csc_matrix
+
+        cdef int[::1] _indptr = np.ascontiguousarray(indptr, dtype=np.intc)
+        cdef int[::1] _indices = np.ascontiguousarray(indices, dtype=np.intc)
+        cdef double[::1] _data = np.ascontiguousarray(data, dtype=np.double)
+        ncols = _indptr.shape[0] - 1
+        # validate the whole matrix before the first variable is created
+        if ncols < 0 or _indptr[0] != 0:
+            raise ValueError("indptr must contain at least one entry and start at 0")
+        for j in range(ncols):
+            if _indptr[j+1] < _indptr[j]:
+                raise ValueError("indptr must be non-decreasing")
+        if _indices.shape[0] != _data.shape[0] or _indices.shape[0] < _indptr[ncols]:
+            raise ValueError("indices and data must have one entry per nonzero")
+        for k in range(_indptr[ncols]):
+            if _indices[k] < 0 or _indices[k] >= nconss:
+                raise IndexError("constraint index %d out of range" % _indices[k])
+
+        cdef double[::1] _obj = np.ascontiguousarray(np.broadcast_to(np.asarray(obj, dtype=np.double), (ncols,)))
+        cdef double[::1] _lb = np.ascontiguousarray(np.broadcast_to(np.asarray(-np.inf if lb is None else lb, dtype=np.double), (ncols,)))
+        cdef double[::1] _ub = np.ascontiguousarray(np.broadcast_to(np.asarray(np.inf if ub is None else ub, dtype=np.double), (ncols,)))
+
+        _vtype = _vartype(vtype.upper())
+
+        if names is not None:
+            cnames = [str_conversion(name) for name in names]
+            if len(cnames) != ncols:
+                raise ValueError("names must contain one entry per column")
+
+        _conss = <SCIP_CONS**> malloc(max(nconss, 1) * sizeof(SCIP_CONS*))
+        try:
+            for i, cons in enumerate(conss):
+                _conss[i] = (<Constraint?>cons).scip_cons
+                if SCIPconsGetHdlr(_conss[i]) != linconshdlr:
+                    constype = bytes(SCIPconshdlrGetName(SCIPconsGetHdlr(_conss[i]))).decode('UTF-8')
+                    raise Warning("cannot add priced variables to constraints of type ", constype)
+                if SCIPconsIsOriginal(_conss[i]):
+                    PY_SCIP_CALL(SCIPgetTransformedCons(self._scip, _conss[i], &transcons))
+                    _conss[i] = transcons
+
+            pyvars = []
+            for j in range(ncols):
+                if names is None:
+                    cname = str_conversion('x'+str(SCIPgetNVars(self._scip)+1))
+                else:
+                    cname = cnames[j]
+
+                varlb = -infinity if _lb[j] <= -infinity else _lb[j]
+                varub = infinity if _ub[j] >= infinity else _ub[j]
+                if _vtype == SCIP_VARTYPE_BINARY:
+                    varlb = max(varlb, 0.0)
+                    varub = min(varub, 1.0)
+
+                PY_SCIP_CALL(SCIPcreateVarBasic(self._scip, &scip_var, cname, varlb, varub, _obj[j], _vtype))
+                PY_SCIP_CALL(SCIPaddPricedVar(self._scip, scip_var, 1.0))
+
+                pyVar = Variable.create(scip_var, self._wrappers)
+                self._modelvars[pyVar.ptr()] = pyVar
+                SCIPvarSetData(scip_var, <SCIP_VARDATA*>pyVar)
+
+                for k in range(_indptr[j], _indptr[j+1]):
+                    PY_SCIP_CALL(SCIPaddCoefLinear(self._scip, _conss[_indices[k]], scip_var, _data[k]))
+
+                PY_SCIP_CALL(SCIPreleaseVar(self._scip, &scip_var))
+                pyvars.append(pyVar)
+        finally:
+            free(_conss)
+
+        return pyvars
+
     def getTransformedVar(self, Variable var):
         """Retrieve the transformed variable.
 
@@ -1453,7 +1930,7 @@ cdef class Model:
         """
         cdef SCIP_VAR* _tvar
         PY_SCIP_CALL(SCIPtransformVar(self._scip, var.scip_var, &_tvar))
-        return Variable.create(_tvar)
+        return Variable.create(_tvar, self._wrappers)
 
     def addVarLocks(self, Variable var, nlocksdown, nlocksup):
         """adds given values to lock numbers of variable for rounding
@@ -1487,6 +1964,11 @@ cdef class Model:
         """
         cdef SCIP_Bool deleted
         PY_SCIP_CALL(SCIPdelVar(self._scip, var.scip_var, &deleted))
+        if deleted:
+            # SCIP may free the variable and reuse its address
+            self._wrappers.origvars.pop(<size_t>var.scip_var, None)
+            self._wrappers.vars.pop(<size_t>var.scip_var, None)
+            self._modelvars.pop(<size_t>var.scip_var, None)
         return deleted
 
     def tightenVarLb(self, Variable var, lb, force=False):
@@ -1555,6 +2037,83 @@ cdef class Model:
         PY_SCIP_CALL(SCIPtightenVarLbGlobal(self._scip, var.scip_var, lb, force, &infeasible, &tightened))
         return infeasible, tightened
 
+    def tightenVarBounds(self, var_indices, lbs, ubs, force=False, vars=None, return_status=False):
+        """Tighten the bounds of several variables in preprocessing or current node, if the bounds are tighter.
+
+        Bounds at infinity, e.g., -inf for lbs or inf for ubs, are skipped. Processing stops at the first
+        variable whose domain becomes empty.
+
+        :param var_indices: indices of the variables to tighten, referring to vars
+        :param lbs: possible new lower bounds, either a scalar or an array of the same length as var_indices
+        :param ubs: possible new upper bounds, either a scalar or an array of the same length as var_indices
+        :param force: force tightening even if below bound strengthening tolerance (Default value = False)
+        :param vars: variables the indices refer to; None uses the transformed problem variables in the order of getVars(transformed=True) (Default value = None)
+        :param return_status: also return the status of every entry (Default value = False)
+        :return: tuple (infeasible, ntightened) or, if return_status is True, (infeasible, ntightened, status)
+                    infeasible: whether some new domain is empty
+                    ntightened: number of bounds that were tightened
+                    status: numpy int8 array with 0 if nothing changed, 1 if the lower bound, 2 if the upper bound,
+                            and 3 if both bounds were tightened, and -1 for the entry that proved infeasibility
+
+        """
+        cdef int[::1] _indices = np.ascontiguousarray(var_indices, dtype=np.intc)
+        cdef int n = _indices.shape[0]
+        cdef double[::1] _lbs = np.ascontiguousarray(np.broadcast_to(np.asarray(lbs, dtype=np.double), (n,)))
+        cdef double[::1] _ubs = np.ascontiguousarray(np.broadcast_to(np.asarray(ubs, dtype=np.double), (n,)))
+        cdef SCIP_VAR** _vars
+        cdef SCIP_Real infinity = SCIPinfinity(self._scip)
+        cdef SCIP_Bool infeasible = False
+        cdef SCIP_Bool tightened
+        cdef int nvars
+        cdef int ntightened = 0
+        cdef int i
+
+        status = np.zeros(n, dtype=np.int8)
+        cdef signed char[::1] _status = status
+
+        if vars is None:
+            _vars = SCIPgetVars(self._scip)
+            nvars = SCIPgetNVars(self._scip)
+        else:
+            nvars = len(vars)
+            _vars = <SCIP_VAR**> malloc(max(nvars, 1) * sizeof(SCIP_VAR*))
+            if _vars == NULL:
+                raise MemoryError()
+
+        try:
+            if vars is not None:
+                for i, var in enumerate(vars):
+                    _vars[i] = (<Variable?>var).scip_var
+
+            for i in range(n):
+                if _indices[i] < 0 or _indices[i] >= nvars:
+                    raise IndexError("variable index %d out of range" % _indices[i])
+
+            for i in range(n):
+                if _lbs[i] > -infinity:
+                    PY_SCIP_CALL(SCIPtightenVarLb(self._scip, _vars[_indices[i]], _lbs[i], force, &infeasible, &tightened))
+                    if infeasible:
+                        _status[i] = -1
+                        break
+                    if tightened:
+                        _status[i] |= 1
+                        ntightened += 1
+                if _ubs[i] < infinity:
+                    PY_SCIP_CALL(SCIPtightenVarUb(self._scip, _vars[_indices[i]], _ubs[i], force, &infeasible, &tightened))
+                    if infeasible:
+                        _status[i] = -1
+                        break
+                    if tightened:
+                        _status[i] |= 2
+                        ntightened += 1
+        finally:
+            if vars is not None:
+                free(_vars)
+
+        if return_status:
+            return infeasible, ntightened, status
+        return infeasible, ntightened
+
     def chgVarLb(self, Variable var, lb):
         """Changes the lower bound of the specified variable.
 
@@ -1643,6 +2202,137 @@ cdef class Model:
         if infeasible:
             print('could not change variable type of variable %s' % var)
 
+    def chgVarBounds(self, vars, lbs=None, ubs=None, scope='local', Node node=None):
+        """Changes the bounds of several variables at once.
+
+        Entries that are NaN are left unchanged; a new lower bound above the upper bound is applied after it.
+        An entry whose new bounds would leave an empty domain, or whose new bounds equal the current ones of the
+        scope, is not changed and reported in the returned masks. For scope 'node', the new bounds are compared
+        with the global bounds.
+
+        :param vars: sequence of variables to change the bounds of
+        :param lbs: new lower bounds, either a scalar or an array of the same length as vars; None keeps them (Default value = None)
+        :param ubs: new upper bounds, either a scalar or an array of the same length as vars; None keeps them (Default value = None)
+        :param scope: 'orig' for the original problem, 'global', 'local' for the current node or problem, 'node' for the given node,
+                      'dive' for the current dive, or 'probing' for the current probing node (Default value = 'local')
+        :param node: the node to change the bounds at for scope 'node' (Default value = None)
+        :return: tuple (infeasible, redundant) of numpy boolean arrays of the same length as vars
+
+        """
+        cdef int n = len(vars)
+        cdef double[::1] _lbs = np.ascontiguousarray(np.broadcast_to(np.asarray(np.nan if lbs is None else lbs, dtype=np.double), (n,)))
+        cdef double[::1] _ubs = np.ascontiguousarray(np.broadcast_to(np.asarray(np.nan if ubs is None else ubs, dtype=np.double), (n,)))
+        cdef SCIP_Real infinity = SCIPinfinity(self._scip)
+        cdef SCIP_NODE* _node = NULL
+        cdef SCIP_VAR* _var
+        cdef SCIP_Real lb, ub, oldlb, oldub
+        cdef int _scope
+        cdef int i
+
+        if scope not in _BOUNDSCOPES:
+            raise ValueError("unrecognized scope %s" % scope)
+        _scope = _BOUNDSCOPES[scope]
+        if _scope == _BOUNDSCOPE_ORIG and SCIPgetStage(self._scip) != SCIP_STAGE_PROBLEM:
+            raise Warning("original bounds can only be changed in the problem stage")
+        if _scope == _BOUNDSCOPE_NODE:
+            if node is None:
+                raise ValueError("scope 'node' needs a node")
+            _node = node.scip_node
+
+        infeasible = np.zeros(n, dtype=bool)
+        redundant = np.zeros(n, dtype=bool)
+        cdef unsigned char[::1] _infeasible = infeasible.view(np.uint8)
+        cdef unsigned char[::1] _redundant = redundant.view(np.uint8)
+
+        for i, var in enumerate(vars):
+            _var = (<Variable?>var).scip_var
+            if _scope == _BOUNDSCOPE_ORIG:
+                oldlb = SCIPvarGetLbOriginal(_var)
+                oldub = SCIPvarGetUbOriginal(_var)
+            elif _scope == _BOUNDSCOPE_GLOBAL or _scope == _BOUNDSCOPE_NODE:
+                oldlb = SCIPvarGetLbGlobal(_var)
+                oldub = SCIPvarGetUbGlobal(_var)
+            else:
+                oldlb = SCIPvarGetLbLocal(_var)
+                oldub = SCIPvarGetUbLocal(_var)
+
+            lb = oldlb if _lbs[i] != _lbs[i] else max(_lbs[i], -infinity)
+            ub = oldub if _ubs[i] != _ubs[i] else min(_ubs[i], infinity)
+            if SCIPisGT(self._scip, lb, ub):
+                _infeasible[i] = True
+                continue
+            if SCIPisEQ(self._scip, lb, oldlb) and SCIPisEQ(self._scip, ub, oldub):
+                _redundant[i] = True
+                continue
+
+            # relax or move the upper bound first if the new lower bound lies above the old upper bound
+            if lb > oldub:
+                _chgVarBound(self._scip, _scope, _node, _var, ub, True)
+                _chgVarBound(self._scip, _scope, _node, _var, lb, False)
+            else:
+                if not SCIPisEQ(self._scip, lb, oldlb):
+                    _chgVarBound(self._scip, _scope, _node, _var, lb, False)
+                if not SCIPisEQ(self._scip, ub, oldub):
+                    _chgVarBound(self._scip, _scope, _node, _var, ub, True)
+
+        return infeasible, redundant
+
+    def fixVars(self, vars, values):
+        """Fixes several variables at once, see fixVar().
+
+        In the problem creation stage, the bounds are set to the fix values regardless of the current bounds, so every
+        variable is reported as fixed and none as infeasible; afterwards, a fix value outside the local bounds of a
+        variable, or a fractional value for an integer variable, is reported as infeasible.
+
+        :param vars: sequence of variables to fix
+        :param values: the fix values, either a scalar or an array of the same length as vars
+        :return: tuple (infeasible, fixed) of numpy boolean arrays of the same length as vars
+
+        """
+        cdef int n = len(vars)
+        cdef double[::1] _values = np.ascontiguousarray(np.broadcast_to(np.asarray(values, dtype=np.double), (n,)))
+        cdef SCIP_Bool _infeasible_i
+        cdef SCIP_Bool _fixed_i
+        cdef int i
+
+        infeasible = np.zeros(n, dtype=bool)
+        fixed = np.zeros(n, dtype=bool)
+        cdef unsigned char[::1] _infeasible = infeasible.view(np.uint8)
+        cdef unsigned char[::1] _fixed = fixed.view(np.uint8)
+
+        for i, var in enumerate(vars):
+            PY_SCIP_CALL(SCIPfixVar(self._scip, (<Variable?>var).scip_var, _values[i], &_infeasible_i, &_fixed_i))
+            _infeasible[i] = _infeasible_i
+            _fixed[i] = _fixed_i
+
+        return infeasible, fixed
+
+    def chgVarTypes(self, vars, vtypes):
+        """Changes the types of several variables at once, see chgVarType().
+
+        :param vars: sequence of variables to change the type of
+        :param vtypes: new variable type, or a sequence of types of the same length as vars
+        :return: numpy boolean array marking the variables whose type change was infeasible
+
+        """
+        cdef int n = len(vars)
+        cdef SCIP_VARTYPE _vtype
+        cdef SCIP_Bool _infeasible_i
+        cdef int i
+
+        if isinstance(vtypes, str):
+            vtypes = [vtypes] * n
+        elif len(vtypes) != n:
+            raise ValueError("expected %d variable types, got %d" % (n, len(vtypes)))
+
+        infeasible = np.zeros(n, dtype=bool)
+        for i, (var, vtype) in enumerate(zip(vars, vtypes)):
+            _vtype = _vartype(vtype)
+            PY_SCIP_CALL(SCIPchgVarType(self._scip, (<Variable?>var).scip_var, _vtype, &_infeasible_i))
+            infeasible[i] = _infeasible_i
+
+        return infeasible
+
     def getVars(self, transformed=False):
         """Retrieve all variables.
 
@@ -1669,13 +2359,51 @@ cdef class Model:
                 vars.append(self._modelvars[ptr])
             else:
                 # create a new variable
-                var = Variable.create(_vars[i])
+                var = Variable.create(_vars[i], self._wrappers)
                 assert var.ptr() == ptr
                 self._modelvars[ptr] = var
                 vars.append(var)
 
         return vars
 
+    def getVarByName(self, name):
+        """Retrieve a variable by its name.
+
+        In the problem stage this finds the original variables. Afterwards, it finds the transformed variables, both by
+        their own names and by the names of their original variables.
+
+        :param name: name of the variable
+        :return: the variable, or None if there is no variable of that name
+
+        """
+        cdef SCIP_VAR* _var = _findvar(self._scip, name)
+        if _var == NULL:
+            return None
+        return Variable.create(_var, self._wrappers)
+
+    def getVarIndicesByName(self, names):
+        """Retrieve the indices of many variables given by their names.
+
+        The indices refer to the order of getVars(transformed=True), e.g., as used by tightenVarBounds(),
+        which in the problem stage is the order of the original variables. Afterwards, names are looked up as by
+        getVarByName(), and variables that are not active anymore, e.g., fixed or aggregated in presolving, give -1.
+
+        :param names: sequence of variable names
+        :return: numpy int array with the index of each variable, or -1 if there is no active variable of that name
+
+        """
+        cdef SCIP_VAR* _var
+        cdef int i
+
+        indices = np.empty(len(names), dtype=np.intc)
+        cdef int[::1] _indices = indices
+
+        for i, name in enumerate(names):
+            _var = _findvar(self._scip, name)
+            _indices[i] = -1 if _var == NULL else SCIPvarGetProbindex(_var)
+
+        return indices
+
     def getNVars(self):
         """Retrieve number of variables in the problems"""
         return SCIPgetNVars(self._scip)
@@ -1697,23 +2425,23 @@ cdef class Model:
     # Node methods
     def getBestChild(self):
         """gets the best child of the focus node w.r.t. the node selection strategy."""
-        return Node.create(SCIPgetBestChild(self._scip))
+        return Node.create(SCIPgetBestChild(self._scip), self._wrappers)
 
     def getBestSibling(self):
         """gets the best sibling of the focus node w.r.t. the node selection strategy."""
-        return Node.create(SCIPgetBestSibling(self._scip))
+        return Node.create(SCIPgetBestSibling(self._scip), self._wrappers)
 
     def getBestLeaf(self):
         """gets the best leaf from the node queue w.r.t. the node selection strategy."""
-        return Node.create(SCIPgetBestLeaf(self._scip))
+        return Node.create(SCIPgetBestLeaf(self._scip), self._wrappers)
 
     def getBestNode(self):
         """gets the best node from the tree (child, sibling, or leaf) w.r.t. the node selection strategy."""
-        return Node.create(SCIPgetBestNode(self._scip))
+        return Node.create(SCIPgetBestNode(self._scip), self._wrappers)
 
     def getBestboundNode(self):
         """gets the node with smallest lower bound from the tree (child, sibling, or leaf)."""
-        return Node.create(SCIPgetBestboundNode(self._scip))
+        return Node.create(SCIPgetBestboundNode(self._scip), self._wrappers)
 
     def getOpenNodes(self):
         """access to all data of open nodes (leaves, children, and siblings)
@@ -1729,12 +2457,66 @@ cdef class Model:
 
         PY_SCIP_CALL(SCIPgetOpenNodesData(self._scip, &_leaves, &_children, &_siblings, &_nleaves, &_nchildren, &_nsiblings))
 
-        leaves   = [Node.create(_leaves[i]) for i in range(_nleaves)]
-        children = [Node.create(_children[i]) for i in range(_nchildren)]
-        siblings = [Node.create(_siblings[i]) for i in range(_nsiblings)]
+        leaves   = [Node.create(_leaves[i], self._wrappers) for i in range(_nleaves)]
+        children = [Node.create(_children[i], self._wrappers) for i in range(_nchildren)]
+        siblings = [Node.create(_siblings[i], self._wrappers) for i in range(_nsiblings)]
 
         return leaves, children, siblings
 
+    def getOpenNodesArrays(self):
+        """access to the data of all open nodes (leaves, children, and siblings) as arrays, without creating a Node for each of them
+
+        The entries are ordered as the leaves, children and siblings of getOpenNodes(); their type tells them apart.
+
+        :return: dict of numpy arrays 'number', 'depth', 'lowerbound', 'estimate', 'type' and 'parent',
+                 where 'parent' holds the number of the parent node, or -1 if there is none
+        """
+        cdef SCIP_NODE** _leaves
+        cdef SCIP_NODE** _children
+        cdef SCIP_NODE** _siblings
+        cdef int _nleaves
+        cdef int _nchildren
+        cdef int _nsiblings
+        cdef SCIP_NODE** _nodes[3]
+        cdef int _nnodes[3]
+        cdef SCIP_NODE* node
+        cdef SCIP_NODE* parent
+        cdef int k, i
+        cdef int pos = 0
+
+        PY_SCIP_CALL(SCIPgetOpenNodesData(self._scip, &_leaves, &_children, &_siblings, &_nleaves, &_nchildren, &_nsiblings))
+        _nodes[0], _nodes[1], _nodes[2] = _leaves, _children, _siblings
+        _nnodes[0], _nnodes[1], _nnodes[2] = _nleaves, _nchildren, _nsiblings
+
+        n = _nleaves + _nchildren + _nsiblings
+        number = np.empty(n, dtype=np.int64)
+        depth = np.empty(n, dtype=np.intc)
+        lowerbound = np.empty(n, dtype=np.double)
+        estimate = np.empty(n, dtype=np.double)
+        nodetype = np.empty(n, dtype=np.intc)
+        parentnumber = np.empty(n, dtype=np.int64)
+        cdef long long[::1] _number = number
+        cdef int[::1] _depth = depth
+        cdef double[::1] _lowerbound = lowerbound
+        cdef double[::1] _estimate = estimate
+        cdef int[::1] _nodetype = nodetype
+        cdef long long[::1] _parentnumber = parentnumber
+
+        for k in range(3):
+            for i in range(_nnodes[k]):
+                node = _nodes[k][i]
+                parent = SCIPnodeGetParent(node)
+                _number[pos] = SCIPnodeGetNumber(node)
+                _depth[pos] = SCIPnodeGetDepth(node)
+                _lowerbound[pos] = SCIPnodeGetLowerbound(node)
+                _estimate[pos] = SCIPnodeGetEstimate(node)
+                _nodetype[pos] = SCIPnodeGetType(node)
+                _parentnumber[pos] = -1 if parent == NULL else SCIPnodeGetNumber(parent)
+                pos += 1
+
+        return {'number': number, 'depth': depth, 'lowerbound': lowerbound, 'estimate': estimate,
+                'type': nodetype, 'parent': parentnumber}
+
     def repropagateNode(self, Node node):
         """marks the given node to be propagated again the next time a node of its subtree is processed"""
         PY_SCIP_CALL(SCIPrepropagateNode(self._scip, node.scip_node))
@@ -1768,7 +2550,7 @@ cdef class Model:
         cdef int ncols
 
         PY_SCIP_CALL(SCIPgetLPColsData(self._scip, &cols, &ncols))
-        return [Column.create(cols[i]) for i in range(ncols)]
+        return [Column.create(cols[i], self._wrappers) for i in range(ncols)]
 
     def getLPRowsData(self):
         """Retrieve current LP rows"""
@@ -1776,7 +2558,7 @@ cdef class Model:
         cdef int nrows
 
         PY_SCIP_CALL(SCIPgetLPRowsData(self._scip, &rows, &nrows))
-        return [Row.create(rows[i]) for i in range(nrows)]
+        return [Row.create(rows[i], self._wrappers) for i in range(nrows)]
 
     def getNLPRows(self):
         """Retrieve the number of rows currently in the LP"""
@@ -1840,7 +2622,7 @@ cdef class Model:
         rhs =  SCIPinfinity(self._scip) if rhs is None else rhs
         scip_sepa = SCIPfindSepa(self._scip, str_conversion(sepa.name))
         PY_SCIP_CALL(SCIPcreateEmptyRowSepa(self._scip, &row, scip_sepa, str_conversion(name), lhs, rhs, local, modifiable, removable))
-        PyRow = Row.create(row)
+        PyRow = Row.create(row, self._wrappers)
         return PyRow
 
     def createEmptyRowUnspec(self, name="row", lhs = 0.0, rhs = None, local = True, modifiable = False, removable = True):
@@ -1857,7 +2639,7 @@ cdef class Model:
         lhs =  -SCIPinfinity(self._scip) if lhs is None else lhs
         rhs =  SCIPinfinity(self._scip) if rhs is None else rhs
         PY_SCIP_CALL(SCIPcreateEmptyRowUnspec(self._scip, &row, str_conversion(name), lhs, rhs, local, modifiable, removable))
-        PyRow = Row.create(row)
+        PyRow = Row.create(row, self._wrappers)
         return PyRow
 
     def getRowActivity(self, Row row):
@@ -1911,6 +2693,112 @@ cdef class Model:
         PY_SCIP_CALL(SCIPaddRow(self._scip, cut.scip_row, forcecut, &infeasible))
         return infeasible
 
+    def addCutsFromArrays(self, Sepa sepa, indptr, var_indices, coefs, lhs, rhs, vars = None, name = "cut",
+                          local = True, modifiable = False, removable = True, forcecut = False):
+        """creates cuts from a separator given in compressed sparse row (CSR) format, keeps those that are efficacious
+        for the current LP solution and adds them to the separation storage
+
+        The nonzeros of cut i are var_indices[indptr[i]:indptr[i+1]] with coefficients coefs[indptr[i]:indptr[i+1]].
+
+        :param sepa: separator that creates the cuts
+        :param indptr: row pointer array of length ncuts + 1
+        :param var_indices: column index of each nonzero, referring to vars
+        :param coefs: coefficient of each nonzero
+        :param lhs: left hand sides of the cuts, either a scalar or an array of length ncuts; use -inf for no left hand side
+        :param rhs: right hand sides of the cuts, either a scalar or an array of length ncuts; use inf for no right hand side
+        :param vars: variables the column indices refer to; None uses the transformed problem variables in the order of getVars(transformed=True) (Default value = None)
+        :param name: name given to all cuts (Default value = "cut")
+        :param local: are the cuts only valid locally? (Default value = True)
+        :param modifiable: are the cuts modifiable during node processing (subject to column generation)? (Default value = False)
+        :param removable: should the cuts be removed from the LP due to aging or cleanup? (Default value = True)
+        :param forcecut: should the cuts be forced to enter the LP? (Default value = False)
+        :return: tuple (nadded, ninefficacious, infeasible) of the number of cuts added, the number of cuts discarded
+                 as not efficacious, and whether some added cut was detected to be infeasible for the local bounds
+        """
+        cdef int[::1] _indptr = np.ascontiguousarray(indptr, dtype=np.intc)
+        cdef int[::1] _indices = np.ascontiguousarray(var_indices, dtype=np.intc)
+        cdef double[::1] _coefs = np.ascontiguousarray(coefs, dtype=np.double)
+        cdef int ncuts = _indptr.shape[0] - 1
+        cdef double[::1] _lhs = np.ascontiguousarray(np.broadcast_to(np.asarray(lhs, dtype=np.double), (max(ncuts, 0),)))
+        cdef double[::1] _rhs = np.ascontiguousarray(np.broadcast_to(np.asarray(rhs, dtype=np.double), (max(ncuts, 0),)))
+        cdef SCIP_VAR** _vars
+        cdef SCIP_VAR** _cutvars
+        cdef SCIP_ROW* row
+        cdef SCIP_SEPA* scip_sepa
+        cdef SCIP_Bool infeasible
+        cdef SCIP_Bool anyinfeasible = False
+        cdef SCIP_Real infinity = SCIPinfinity(self._scip)
+        cdef SCIP_Real rowlhs
+        cdef SCIP_Real rowrhs
+        cdef int nvars
+        cdef int nadded = 0
+        cdef int ninefficacious = 0
+        cdef int i
+        cdef int j
+        cdef int k
+        cdef int start
+        cdef int length
+
+        # validate the whole input before the first row is created
+        if ncuts < 0 or _indptr[0] != 0:
+            raise ValueError("indptr must contain at least one entry and start at 0")
+        for i in range(ncuts):
+            if _indptr[i+1] < _indptr[i]:
+                raise ValueError("indptr must be non-decreasing")
+        if _indices.shape[0] != _coefs.shape[0] or _indices.shape[0] < _indptr[ncuts]:
+            raise ValueError("var_indices and coefs must have one entry per nonzero")
+
+        nvars = SCIPgetNVars(self._scip) if vars is None else len(vars)
+        for k in range(_indptr[ncuts]):
+            if _indices[k] < 0 or _indices[k] >= nvars:
+                raise IndexError("variable index %d out of range" % _indices[k])
+
+        if vars is None:
+            _vars = SCIPgetVars(self._scip)
+        else:
+            _vars = <SCIP_VAR**> malloc(max(nvars, 1) * sizeof(SCIP_VAR*))
+        _cutvars = <SCIP_VAR**> malloc(max(_indptr[ncuts], 1) * sizeof(SCIP_VAR*))
+        try:
+            if _vars == NULL or _cutvars == NULL:
+                raise MemoryError()
+            if vars is not None:
+                for i, var in enumerate(vars):
+                    _vars[i] = (<Variable?>var).scip_var
+            for k in range(_indptr[ncuts]):
+                _cutvars[k] = _vars[_indices[k]]
+
+            scip_sepa = SCIPfindSepa(self._scip, str_conversion(sepa.name))
+            cname = str_conversion(name)
+
+            for i in range(ncuts):
+                start = _indptr[i]
+                length = _indptr[i+1] - start
+                rowlhs = -infinity if _lhs[i] <= -infinity else _lhs[i]
+                rowrhs = infinity if _rhs[i] >= infinity else _rhs[i]
+
+                PY_SCIP_CALL(SCIPcreateEmptyRowSepa(self._scip, &row, scip_sepa, cname, rowlhs, rowrhs, local, modifiable, removable))
+                try:
+                    if length > 0:
+                        PY_SCIP_CALL(SCIPaddVarsToRow(self._scip, row, length, &_cutvars[start], &_coefs[start]))
+
+                    if forcecut or SCIPisCutEfficacious(self._scip, NULL, row):
+                        PY_SCIP_CALL(SCIPaddRow(self._scip, row, forcecut, &infeasible))
+                        anyinfeasible = anyinfeasible or infeasible
+                        nadded += 1
+                    else:
+                        ninefficacious += 1
+                except:
+                    # the return code is ignored, such that the original exception is raised
+                    SCIPreleaseRow(self._scip, &row)
+                    raise
+                PY_SCIP_CALL(SCIPreleaseRow(self._scip, &row))
+        finally:
+            free(_cutvars)
+            if vars is not None:
+                free(_vars)
+
+        return nadded, ninefficacious, anyinfeasible
+
     def getNCuts(self):
         """Retrieve total number of cuts in storage"""
         return SCIPgetNCuts(self._scip)
@@ -1962,7 +2850,13 @@ cdef class Model:
         :param removable: should the relaxation be removed from the LP due to aging or cleanup? (Default value = False)
         :param stickingatnode: should the constraint always be kept at the node where it was added, even if it may be  moved to a more global node? (Default value = False)
 
+        A MatrixExprCons is passed on to addMatrixCons(), which returns an array of constraints.
+
         """
+        if isinstance(cons, MatrixExprCons):
+            return self.addMatrixCons(cons, name=name, initial=initial, separate=separate, enforce=enforce, check=check,
+                                      propagate=propagate, local=local, modifiable=modifiable, dynamic=dynamic,
+                                      removable=removable, stickingatnode=stickingatnode)
         assert isinstance(cons, ExprCons), "given constraint is not ExprCons but %s" % cons.__class__.__name__
 
         # replace empty name with generic one
@@ -1988,6 +2882,318 @@ cdef class Model:
         else:
             return self._addNonlinearCons(cons, **kwargs)
 
+    cdef int _addStagedLinearConss(self, list names, int nstaged, int* starts, SCIP_VAR** vars, SCIP_Real* coefs,
+                                   SCIP_Real* lhss, SCIP_Real* rhss, SCIP_Bool* flags, list pyconss) except -1:
+        """creates and adds the linear constraints staged by addConss(), appending them to pyconss unless it is None"""
+        cdef SCIP_CONS* scip_cons
+        cdef int i
+        for i in range(nstaged):
+            PY_SCIP_CALL(SCIPcreateConsLinear(
+                self._scip, &scip_cons, names[i], starts[i+1] - starts[i], &vars[starts[i]], &coefs[starts[i]],
+                lhss[i], rhss[i], flags[0], flags[1], flags[2], flags[3], flags[4], flags[5], flags[6], flags[7],
+                flags[8], flags[9]))
+            PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
+            if pyconss is not None:
+                pyconss.append(Constraint.create(scip_cons, self._wrappers))
+            PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
+        return 0
+
+    def addConss(self, conss, names=None, chunksize=10000, return_conss=False, initial=True, separate=True,
+                 enforce=True, check=True, propagate=True, local=False, modifiable=False, dynamic=False,
+                 removable=False, stickingatnode=False):
+        """Add many constraints, e.g., given by a generator, which is consumed lazily.
+
+        Linear constraints are collected in a staging buffer and created in chunks, so that the memory used does not
+        depend on the total number of constraints. Nonlinear constraints are passed on to addCons(); the order of the
+        constraints is kept. If an exception is raised, all constraints before the failing one have been added.
+
+        :param conss: iterable of ExprCons
+        :param names: iterable of constraint names, generic names if None (Default value = None)
+        :param chunksize: maximal number of linear constraints that are staged before they are added (Default value = 10000)
+        :param return_conss: should the constraints be returned? (Default value = False)
+        :param initial: should the LP relaxation of constraint be in the initial LP? (Default value = True)
+        :param separate: should the constraint be separated during LP processing? (Default value = True)
+        :param enforce: should the constraint be enforced during node processing? (Default value = True)
+        :param check: should the constraint be checked during for feasibility? (Default value = True)
+        :param propagate: should the constraint be propagated during node processing? (Default value = True)
+        :param local: is the constraint only valid locally? (Default value = False)
+        :param modifiable: is the constraint modifiable (subject to column generation)? (Default value = False)
+        :param dynamic: is the constraint subject to aging? (Default value = False)
+        :param removable: should the relaxation be removed from the LP due to aging or cleanup? (Default value = False)
+        :param stickingatnode: should the constraint always be kept at the node where it was added, even if it may be  moved to a more global node? (Default value = False)
+        :return: list of the added constraints if return_conss is True, otherwise the number of added constraints
+
+        """
+        cdef SCIP_VAR** _vars = NULL
+        cdef SCIP_Real* _coefs = NULL
+        cdef SCIP_Real* _lhss = NULL
+        cdef SCIP_Real* _rhss = NULL
+        cdef int* _starts = NULL
+        cdef void* ptr
+        cdef SCIP_Real infinity = SCIPinfinity(self._scip)
+        cdef int nconss = SCIPgetNConss(self._scip)
+        cdef int nadded = 0
+        cdef int nstaged = 0
+        cdef int nnz = 0
+        cdef int nnzsize = 1024
+        cdef int n
+        cdef SCIP_Bool _flags[10]
+
+        if chunksize < 1:
+            raise ValueError("chunksize must be positive")
+
+        flags = dict(initial=initial, separate=separate, enforce=enforce, check=check, propagate=propagate,
+                     local=local, modifiable=modifiable, dynamic=dynamic, removable=removable,
+                     stickingatnode=stickingatnode)
+        for i, flag in enumerate((initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable,
+                                  stickingatnode)):
+            _flags[i] = flag
+        nameiter = None if names is None else iter(names)
+        stagednames = []
+        pyconss = [] if return_conss else None
+
+        _vars = <SCIP_VAR**> malloc(nnzsize * sizeof(SCIP_VAR*))
+        _coefs = <SCIP_Real*> malloc(nnzsize * sizeof(SCIP_Real))
+        _lhss = <SCIP_Real*> malloc(chunksize * sizeof(SCIP_Real))
+        _rhss = <SCIP_Real*> malloc(chunksize * sizeof(SCIP_Real))
+        _starts = <int*> malloc((chunksize + 1) * sizeof(int))
+        try:
+            if _vars == NULL or _coefs == NULL or _lhss == NULL or _rhss == NULL or _starts == NULL:
+                raise MemoryError()
+            _starts[0] = 0
+
+            try:
+                for cons in conss:
+                    assert isinstance(cons, ExprCons), "given constraint is not ExprCons but %s" % cons.__class__.__name__
+                    if nameiter is None:
+                        name = 'c'+str(nconss+1)
+                    else:
+                        try:
+                            name = next(nameiter)
+                        except StopIteration:
+                            raise ValueError("names must contain one entry per constraint") from None
+                    nconss += 1
+                    linear = cons.expr.degree() <= 1
+
+                    # create all staged linear constraints
+                    if not linear or nstaged == chunksize:
+                        # unstage them first, such that they are not created again if this fails
+                        n, nstaged, nnz = nstaged, 0, 0
+                        self._addStagedLinearConss(stagednames, n, _starts, _vars, _coefs, _lhss, _rhss, _flags, pyconss)
+                        nadded += n
+                        stagednames = []
+
+                    if not linear:
+                        pycons = self.addCons(cons, name, **flags)
+                        nadded += 1
+                        if return_conss:
+                            pyconss.append(pycons)
+                        continue
+
+                    # stage the linear constraint
+                    terms = cons.expr.terms
+                    if nnz + len(terms) > nnzsize:
+                        nnzsize = max(2 * nnzsize, nnz + len(terms))
+                        ptr = realloc(_vars, nnzsize * sizeof(SCIP_VAR*))
+                        if ptr == NULL:
+                            raise MemoryError()
+                        _vars = <SCIP_VAR**> ptr
+                        ptr = realloc(_coefs, nnzsize * sizeof(SCIP_Real))
+                        if ptr == NULL:
+                            raise MemoryError()
+                        _coefs = <SCIP_Real*> ptr
+                    for key, coeff in terms.items():
+                        _vars[nnz] = (<Variable>key[0]).scip_var
+                        _coefs[nnz] = <SCIP_Real>coeff
+                        nnz += 1
+                    _lhss[nstaged] = -infinity if cons._lhs is None else cons._lhs
+                    _rhss[nstaged] = infinity if cons._rhs is None else cons._rhs
+                    stagednames.append(str_conversion(name))
+                    nstaged += 1
+                    _starts[nstaged] = nnz
+            finally:
+                # create the remaining staged linear constraints, which precede a failing constraint
+                self._addStagedLinearConss(stagednames, nstaged, _starts, _vars, _coefs, _lhss, _rhss, _flags, pyconss)
+                nadded += nstaged
+        finally:
+            free(_vars)
+            free(_coefs)
+            free(_lhss)
+            free(_rhss)
+            free(_starts)
+
+        if return_conss:
+            return pyconss
+        return nadded
+
+    def addMatrixCons(self, cons, name='', initial=True, separate=True, enforce=True, check=True,
+                      propagate=True, local=False, modifiable=False, dynamic=False, removable=False,
+                      stickingatnode=False):
+        """Add one linear constraint per element of a MatrixExprCons, directly from its sparse rows.
+
+        :param cons: MatrixExprCons, e.g., A @ x <= b for a MatrixVariable x
+        :param name: prefix of the names of the constraints, to which the index is appended; generic names if empty (Default value = '')
+        :param initial: should the LP relaxation of constraint be in the initial LP? (Default value = True)
+        :param separate: should the constraint be separated during LP processing? (Default value = True)
+        :param enforce: should the constraint be enforced during node processing? (Default value = True)
+        :param check: should the constraint be checked for feasibility? (Default value = True)
+        :param propagate: should the constraint be propagated during node processing? (Default value = True)
+        :param local: is the constraint only valid locally? (Default value = False)
+        :param modifiable: is the constraint modifiable (subject to column generation)? (Default value = False)
+        :param dynamic: is the constraint subject to aging? (Default value = False)
+        :param removable: should the relaxation be removed from the LP due to aging or cleanup? (Default value = False)
+        :param stickingatnode: should the constraint always be kept at the node where it was added, even if it may be moved to a more global node? (Default value = False)
+        :return: numpy array of the added constraints, of the same shape as cons
+
+        """
+        cdef SCIP_CONS* scip_cons
+        cdef SCIP_Real infinity = SCIPinfinity(self._scip)
+        cdef Py_ssize_t[::1] _indptr
+        cdef Py_ssize_t[::1] _indices
+        cdef double[::1] _data
+        cdef double[::1] _lhs
+        cdef double[::1] _rhs
+        cdef Py_ssize_t start
+        cdef int length
+        cdef Py_ssize_t k
+
+        assert isinstance(cons, MatrixExprCons), "given constraint is not MatrixExprCons but %s" % cons.__class__.__name__
+        expr = cons.expr
+        # the variable pointers are only valid for the current problem of this model
+        if expr.indices.shape[0] > 0 and expr._cache is not self._wrappers:
+            raise ValueError("the variables of the MatrixExprCons do not belong to the problem of this model")
+        _indptr = expr.indptr
+        _indices = expr.indices
+        _data = expr.data
+
+        # move the constants to the sides
+        constant = expr.constant.ravel()
+        _lhs = np.full(expr.size, -infinity) if cons.lhs is None else np.maximum(cons.lhs.ravel() - constant, -infinity)
+        _rhs = np.full(expr.size, infinity) if cons.rhs is None else np.minimum(cons.rhs.ravel() - constant, infinity)
+
+        pyconss = np.empty(expr.size, dtype=object)
+        for k, index in enumerate(np.ndindex(*expr.shape)):
+            if name == '':
+                cname = str_conversion('c'+str(SCIPgetNConss(self._scip)+1))
+            else:
+                cname = str_conversion(name + ''.join('_%d' % i for i in index))
+            start = _indptr[k]
+            length = <int>(_indptr[k+1] - start)
+            # the variable pointers are stored as integers of pointer size
+            PY_SCIP_CALL(SCIPcreateConsLinear(self._scip, &scip_cons, cname, length,
+                <SCIP_VAR**>&_indices[start] if length > 0 else NULL, &_data[start] if length > 0 else NULL,
+                _lhs[k], _rhs[k], initial, separate, enforce, check, propagate, local, modifiable, dynamic,
+                removable, stickingatnode))
+            PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
+            pyconss[k] = Constraint.create(scip_cons, self._wrappers)
+            PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
+
+        return pyconss.reshape(expr.shape)
+
+    def addQuadCons(self, Q_coo, c=None, lhs=None, rhs=None, vars=None, name='', initial=True, separate=True,
+                    enforce=True, check=True, propagate=True, local=False, modifiable=False, dynamic=False,
+                    removable=False):
+        """Add the quadratic constraint lhs <= x'Qx + c'x <= rhs, given by arrays and without building an expression.
+
+        :param Q_coo: quadratic part as tuple (row, col, data) in coordinate format, where entry k contributes
+                      data[k]*x[row[k]]*x[col[k]]; a scipy.sparse matrix or a dense matrix is accepted as well
+        :param c: coefficients of the linear part, one per variable (Default value = None)
+        :param lhs: left hand side, None for -infinity (Default value = None)
+        :param rhs: right hand side, None for infinity (Default value = None)
+        :param vars: variables x the indices refer to; None uses the variables in the order of getVars() (Default value = None)
+        :param name: the name of the constraint, generic name if empty (Default value = '')
+        :param initial: should the LP relaxation of constraint be in the initial LP? (Default value = True)
+        :param separate: should the constraint be separated during LP processing? (Default value = True)
+        :param enforce: should the constraint be enforced during node processing? (Default value = True)
+        :param check: should the constraint be checked for feasibility? (Default value = True)
+        :param propagate: should the constraint be propagated during node processing? (Default value = True)
+        :param local: is the constraint only valid locally? (Default value = False)
+        :param modifiable: is the constraint modifiable (subject to column generation)? (Default value = False)
+        :param dynamic: is the constraint subject to aging? (Default value = False)
+        :param removable: should the relaxation be removed from the LP due to aging or cleanup? (Default value = False)
+        :return: the added @ref scip#Constraint "Constraint" object
+
+        """
+        cdef int[::1] _row
+        cdef int[::1] _col
+        cdef double[::1] _data
+        cdef double[::1] _c
+        cdef SCIP_VAR** _vars
+        cdef SCIP_VAR** _linvars
+        cdef SCIP_VAR** _quadvars1
+        cdef SCIP_VAR** _quadvars2
+        cdef SCIP_Real* _lincoefs
+        cdef SCIP_Real* _quadcoefs
+        cdef SCIP_CONS* scip_cons
+        cdef SCIP_Real infinity = SCIPinfinity(self._scip)
+        cdef int nvars
+        cdef int nlinvars = 0
+        cdef int nquadterms
+        cdef int i
+        cdef int k
+
+        _row, _col, _data = _coo_arrays(Q_coo)
+        nquadterms = _data.shape[0]
+        if _row.shape[0] != nquadterms or _col.shape[0] != nquadterms:
+            raise ValueError("row, col and data of Q must have the same length")
+
+        if vars is None:
+            _vars = SCIPgetVars(self._scip)
+            nvars = SCIPgetNVars(self._scip)
+        else:
+            _vars = NULL
+            nvars = len(vars)
+
+        if name == '':
+            name = 'c'+str(SCIPgetNConss(self._scip)+1)
+
+        # all temporary arrays share one piece of scratch memory
+        _linvars = <SCIP_VAR**> self._getScratch((nvars + 2 * nquadterms) * sizeof(SCIP_VAR*) + (nvars + nquadterms) * sizeof(SCIP_Real))
+        _quadvars1 = &_linvars[nvars]
+        _quadvars2 = &_quadvars1[nquadterms]
+        _lincoefs = <SCIP_Real*> &_quadvars2[nquadterms]
+        _quadcoefs = &_lincoefs[nvars]
+        try:
+            if vars is not None:
+                _vars = <SCIP_VAR**> malloc(max(nvars, 1) * sizeof(SCIP_VAR*))
+                if _vars == NULL:
+                    raise MemoryError()
+                for i, var in enumerate(vars):
+                    _vars[i] = (<Variable?>var).scip_var
+
+            if c is not None:
+                _c = np.ascontiguousarray(c, dtype=np.double)
+                if _c.shape[0] != nvars:
+                    raise ValueError("expected %d linear coefficients, got %d" % (nvars, _c.shape[0]))
+                for i in range(nvars):
+                    if _c[i] != 0.0:
+                        _linvars[nlinvars] = _vars[i]
+                        _lincoefs[nlinvars] = _c[i]
+                        nlinvars += 1
+
+            for k in range(nquadterms):
+                if _row[k] < 0 or _row[k] >= nvars or _col[k] < 0 or _col[k] >= nvars:
+                    raise IndexError("variable index of quadratic term %d out of range" % k)
+                _quadvars1[k] = _vars[_row[k]]
+                _quadvars2[k] = _vars[_col[k]]
+                _quadcoefs[k] = _data[k]
+
+            PY_SCIP_CALL(SCIPcreateConsQuadratic(
+                self._scip, &scip_cons, str_conversion(name),
+                nlinvars, _linvars, _lincoefs,
+                nquadterms, _quadvars1, _quadvars2, _quadcoefs,
+                -infinity if lhs is None else lhs, infinity if rhs is None else rhs,
+                initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable))
+        finally:
+            self._releaseScratch(_linvars)
+            if vars is not None:
+                free(_vars)
+
+        PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
+        PyCons = Constraint.create(scip_cons, self._wrappers)
+        PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
+        return PyCons
+
     def _addLinCons(self, ExprCons lincons, **kwargs):
         assert isinstance(lincons, ExprCons), "given constraint is not ExprCons but %s" % lincons.__class__.__name__
 
@@ -1995,30 +3201,31 @@ cdef class Model:
         terms = lincons.expr.terms
 
         cdef SCIP_CONS* scip_cons
+        cdef SCIP_VAR** vars_array
+        cdef SCIP_Real* coeffs_array
 
         cdef int nvars = len(terms.items())
 
-        vars_array = <SCIP_VAR**> malloc(nvars * sizeof(SCIP_VAR*))
-        coeffs_array = <SCIP_Real*> malloc(nvars * sizeof(SCIP_Real))
-
-        for i, (key, coeff) in enumerate(terms.items()):
-            vars_array[i] = <SCIP_VAR*>(<Variable>key[0]).scip_var
-            coeffs_array[i] = <SCIP_Real>coeff
-
-        PY_SCIP_CALL(SCIPcreateConsLinear(
-            self._scip, &scip_cons, str_conversion(kwargs['name']), nvars, vars_array, coeffs_array,
-            kwargs['lhs'], kwargs['rhs'], kwargs['initial'],
-            kwargs['separate'], kwargs['enforce'], kwargs['check'],
-            kwargs['propagate'], kwargs['local'], kwargs['modifiable'],
-            kwargs['dynamic'], kwargs['removable'], kwargs['stickingatnode']))
+        vars_array = <SCIP_VAR**> self._getScratch(nvars * (sizeof(SCIP_VAR*) + sizeof(SCIP_Real)))
+        coeffs_array = <SCIP_Real*> &vars_array[nvars]
+        try:
+            for i, (key, coeff) in enumerate(terms.items()):
+                vars_array[i] = <SCIP_VAR*>(<Variable>key[0]).scip_var
+                coeffs_array[i] = <SCIP_Real>coeff
+
+            PY_SCIP_CALL(SCIPcreateConsLinear(
+                self._scip, &scip_cons, str_conversion(kwargs['name']), nvars, vars_array, coeffs_array,
+                kwargs['lhs'], kwargs['rhs'], kwargs['initial'],
+                kwargs['separate'], kwargs['enforce'], kwargs['check'],
+                kwargs['propagate'], kwargs['local'], kwargs['modifiable'],
+                kwargs['dynamic'], kwargs['removable'], kwargs['stickingatnode']))
+        finally:
+            self._releaseScratch(vars_array)
 
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        PyCons = Constraint.create(scip_cons)
+        PyCons = Constraint.create(scip_cons, self._wrappers)
         PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
 
-        free(vars_array)
-        free(coeffs_array)
-
         return PyCons
 
     def _addQuadCons(self, ExprCons quadcons, **kwargs):
@@ -2045,7 +3252,7 @@ cdef class Model:
                 PY_SCIP_CALL(SCIPaddBilinTermQuadratic(self._scip, scip_cons, var1.scip_var, var2.scip_var, c))
 
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        PyCons = Constraint.create(scip_cons)
+        PyCons = Constraint.create(scip_cons, self._wrappers)
         PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
         return PyCons
 
@@ -2057,6 +3264,8 @@ cdef class Model:
         cdef SCIP_EXPRTREE* exprtree
         cdef SCIP_VAR** vars
         cdef SCIP_CONS* scip_cons
+        cdef int nvars
+        cdef int nterms
 
         terms = cons.expr.terms
 
@@ -2064,33 +3273,39 @@ cdef class Model:
         variables = {var.ptr():var for term in terms for var in term}
         variables = list(variables.values())
         varindex = {var.ptr():idx for (idx,var) in enumerate(variables)}
-
-        # create variable expressions
-        varexprs = <SCIP_EXPR**> malloc(len(varindex) * sizeof(SCIP_EXPR*))
-        for idx in varindex.values():
-            PY_SCIP_CALL( SCIPexprCreate(SCIPblkmem(self._scip), &expr, SCIP_EXPR_VARIDX, <int>idx) )
-            varexprs[idx] = expr
-
-        # create monomials for terms
-        monomials = <SCIP_EXPRDATA_MONOMIAL**> malloc(len(terms) * sizeof(SCIP_EXPRDATA_MONOMIAL*))
-        for i, (term, coef) in enumerate(terms.items()):
-            idxs = <int*> malloc(len(term) * sizeof(int))
-            for j, var in enumerate(term):
-                idxs[j] = varindex[var.ptr()]
-            PY_SCIP_CALL( SCIPexprCreateMonomial(SCIPblkmem(self._scip), &monomials[i], <SCIP_Real>coef, <int>len(term), idxs, NULL) )
-            free(idxs)
-
-        # create polynomial from monomials
-        PY_SCIP_CALL( SCIPexprCreatePolynomial(SCIPblkmem(self._scip), &expr,
-                                               <int>len(varindex), varexprs,
-                                               <int>len(terms), monomials, 0.0, <SCIP_Bool>True) )
-
-        # create expression tree
-        PY_SCIP_CALL( SCIPexprtreeCreate(SCIPblkmem(self._scip), &exprtree, expr, <int>len(variables), 0, NULL) )
-        vars = <SCIP_VAR**> malloc(len(variables) * sizeof(SCIP_VAR*))
-        for idx, var in enumerate(variables): # same as varindex
-            vars[idx] = (<Variable>var).scip_var
-        PY_SCIP_CALL( SCIPexprtreeSetVars(exprtree, <int>len(variables), vars) )
+        nvars = len(variables)
+        nterms = len(terms)
+
+        # all temporary arrays share one piece of scratch memory; the int array comes last for alignment
+        varexprs = <SCIP_EXPR**> self._getScratch(2 * nvars * sizeof(SCIP_EXPR*) + nterms * sizeof(SCIP_EXPRDATA_MONOMIAL*)
+                                                  + cons.expr.degree() * sizeof(int))
+        vars = <SCIP_VAR**> &varexprs[nvars]
+        monomials = <SCIP_EXPRDATA_MONOMIAL**> &vars[nvars]
+        idxs = <int*> &monomials[nterms]
+        try:
+            # create variable expressions
+            for idx in varindex.values():
+                PY_SCIP_CALL( SCIPexprCreate(SCIPblkmem(self._scip), &expr, SCIP_EXPR_VARIDX, <int>idx) )
+                varexprs[idx] = expr
+
+            # create monomials for terms
+            for i, (term, coef) in enumerate(terms.items()):
+                for j, var in enumerate(term):
+                    idxs[j] = varindex[var.ptr()]
+                PY_SCIP_CALL( SCIPexprCreateMonomial(SCIPblkmem(self._scip), &monomials[i], <SCIP_Real>coef, <int>len(term), idxs, NULL) )
+
+            # create polynomial from monomials
+            PY_SCIP_CALL( SCIPexprCreatePolynomial(SCIPblkmem(self._scip), &expr,
+                                                   nvars, varexprs,
+                                                   nterms, monomials, 0.0, <SCIP_Bool>True) )
+
+            # create expression tree
+            PY_SCIP_CALL( SCIPexprtreeCreate(SCIPblkmem(self._scip), &exprtree, expr, nvars, 0, NULL) )
+            for idx, var in enumerate(variables): # same as varindex
+                vars[idx] = (<Variable>var).scip_var
+            PY_SCIP_CALL( SCIPexprtreeSetVars(exprtree, nvars, vars) )
+        finally:
+            self._releaseScratch(varexprs)
 
         # create nonlinear constraint for exprtree
         PY_SCIP_CALL( SCIPcreateConsNonlinear(
@@ -2103,87 +3318,33 @@ cdef class Model:
             kwargs['modifiable'], kwargs['dynamic'], kwargs['removable'],
             kwargs['stickingatnode']) )
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        PyCons = Constraint.create(scip_cons)
+        PyCons = Constraint.create(scip_cons, self._wrappers)
         PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
         PY_SCIP_CALL( SCIPexprtreeFree(&exprtree) )
-        free(vars)
-        free(monomials)
-        free(varexprs)
         return PyCons
 
     def _addGenNonlinearCons(self, ExprCons cons, **kwargs):
-        cdef SCIP_EXPR** childrenexpr
-        cdef SCIP_EXPR** scipexprs
+        cdef SCIP_EXPR* root
         cdef SCIP_EXPRTREE* exprtree
+        cdef SCIP_VAR** vars
         cdef SCIP_CONS* scip_cons
-        cdef int nchildren
+        cdef int nvars
 
-        # get arrays from python's expression tree
-        expr = cons.expr
-        nodes = expr_to_nodes(expr)
-        op2idx = Operator.operatorIndexDic
-
-        # in nodes we have a list of tuples: each tuple is of the form
-        # (operator, [indices]) where indices are the indices of the tuples
-        # that are the children of this operator. This is sorted,
-        # so we are going to do is:
-        # loop over the nodes and create the expression of each
-        # Note1: when the operator is SCIP_EXPR_CONST, [indices] stores the value
-        # Note2: we need to compute the number of variable operators to find out
-        # how many variables are there.
-        nvars = 0
-        for node in nodes:
-            if op2idx[node[0]] == SCIP_EXPR_VARIDX:
-                nvars += 1
-        vars = <SCIP_VAR**> malloc(nvars * sizeof(SCIP_VAR*))
-
-        varpos = 0
-        scipexprs = <SCIP_EXPR**> malloc(len(nodes) * sizeof(SCIP_EXPR*))
-        for i,node in enumerate(nodes):
-            op = node[0]
-            opidx = op2idx[op]
-            if opidx == SCIP_EXPR_VARIDX:
-                assert len(node[1]) == 1
-                pyvar = node[1][0] # for vars we store the actual var!
-                PY_SCIP_CALL( SCIPexprCreate(SCIPblkmem(self._scip), &scipexprs[i], opidx, <int>varpos) )
-                vars[varpos] = (<Variable>pyvar).scip_var
-                varpos += 1
-                continue
-            if opidx == SCIP_EXPR_CONST:
-                assert len(node[1]) == 1
-                value = node[1][0]
-                PY_SCIP_CALL( SCIPexprCreate(SCIPblkmem(self._scip), &scipexprs[i], opidx, <SCIP_Real>value) )
-                continue
-            if opidx == SCIP_EXPR_SUM or opidx == SCIP_EXPR_PRODUCT:
-                nchildren = len(node[1])
-                childrenexpr = <SCIP_EXPR**> malloc(nchildren * sizeof(SCIP_EXPR*))
-                for c, pos in enumerate(node[1]):
-                    childrenexpr[c] = scipexprs[pos]
-                PY_SCIP_CALL( SCIPexprCreate(SCIPblkmem(self._scip), &scipexprs[i], opidx, nchildren, childrenexpr) )
-
-                free(childrenexpr)
-                continue
-            if opidx == SCIP_EXPR_REALPOWER:
-                # the second child is the exponent which is a const
-                valuenode = nodes[node[1][1]]
-                assert op2idx[valuenode[0]] == SCIP_EXPR_CONST
-                exponent = valuenode[1][0]
-                if float(exponent).is_integer():
-                    PY_SCIP_CALL( SCIPexprCreate(SCIPblkmem(self._scip), &scipexprs[i], SCIP_EXPR_INTPOWER, scipexprs[node[1][0]], <int>exponent) )
-                else:
-                    PY_SCIP_CALL( SCIPexprCreate(SCIPblkmem(self._scip), &scipexprs[i], opidx, scipexprs[node[1][0]], <SCIP_Real>exponent) )
-                continue
-            if opidx == SCIP_EXPR_EXP or opidx == SCIP_EXPR_LOG or opidx == SCIP_EXPR_SQRT or opidx == SCIP_EXPR_ABS:
-                assert len(node[1]) == 1
-                PY_SCIP_CALL( SCIPexprCreate(SCIPblkmem(self._scip), &scipexprs[i], opidx, scipexprs[node[1][0]]) )
-                continue
-            # default:
-            raise NotImplementedError
-        assert varpos == nvars
+        # create SCIP's expression directly from python's expression graph
+        variables = []
+        root = _genexpr_to_scip(self._scip, cons.expr, variables)
+        nvars = len(variables)
 
-        # create expression tree
-        PY_SCIP_CALL( SCIPexprtreeCreate(SCIPblkmem(self._scip), &exprtree, scipexprs[len(nodes) - 1], nvars, 0, NULL) )
-        PY_SCIP_CALL( SCIPexprtreeSetVars(exprtree, <int>nvars, vars) )
+        vars = <SCIP_VAR**> self._getScratch(nvars * sizeof(SCIP_VAR*))
+        try:
+            for i, var in enumerate(variables):
+                vars[i] = (<Variable>var).scip_var
+
+            # create expression tree
+            PY_SCIP_CALL( SCIPexprtreeCreate(SCIPblkmem(self._scip), &exprtree, root, nvars, 0, NULL) )
+            PY_SCIP_CALL( SCIPexprtreeSetVars(exprtree, <int>nvars, vars) )
+        finally:
+            self._releaseScratch(vars)
 
         # create nonlinear constraint for exprtree
         PY_SCIP_CALL( SCIPcreateConsNonlinear(
@@ -2196,14 +3357,10 @@ cdef class Model:
             kwargs['modifiable'], kwargs['dynamic'], kwargs['removable'],
             kwargs['stickingatnode']) )
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        PyCons = Constraint.create(scip_cons)
+        PyCons = Constraint.create(scip_cons, self._wrappers)
         PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
         PY_SCIP_CALL( SCIPexprtreeFree(&exprtree) )
 
-        # free more memory
-        free(scipexprs)
-        free(vars)
-
         return PyCons
 
     def addConsCoeff(self, Constraint cons, Variable var, coeff):
@@ -2264,23 +3421,27 @@ cdef class Model:
 
         """
         cdef SCIP_CONS* scip_cons
-        cdef int _nvars
-
-        PY_SCIP_CALL(SCIPcreateConsSOS1(self._scip, &scip_cons, str_conversion(name), 0, NULL, NULL,
-            initial, separate, enforce, check, propagate, local, dynamic, removable, stickingatnode))
+        cdef SCIP_VAR** _vars
+        cdef SCIP_Real* _weights
+        cdef int _nvars = len(vars)
 
-        if weights is None:
-            for v in vars:
-                var = <Variable>v
-                PY_SCIP_CALL(SCIPappendVarSOS1(self._scip, scip_cons, var.scip_var))
-        else:
-            nvars = len(vars)
-            for i in range(nvars):
-                var = <Variable>vars[i]
-                PY_SCIP_CALL(SCIPaddVarSOS1(self._scip, scip_cons, var.scip_var, weights[i]))
+        _vars = <SCIP_VAR**> self._getScratch(_nvars * (sizeof(SCIP_VAR*) + sizeof(SCIP_Real)))
+        _weights = <SCIP_Real*> &_vars[_nvars]
+        try:
+            for i, var in enumerate(vars):
+                _vars[i] = (<Variable>var).scip_var
+                if weights is not None:
+                    _weights[i] = weights[i]
+
+            # without weights, the variables are ordered as given
+            PY_SCIP_CALL(SCIPcreateConsSOS1(self._scip, &scip_cons, str_conversion(name), _nvars, _vars,
+                NULL if weights is None else _weights,
+                initial, separate, enforce, check, propagate, local, dynamic, removable, stickingatnode))
+        finally:
+            self._releaseScratch(_vars)
 
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        return Constraint.create(scip_cons)
+        return Constraint.create(scip_cons, self._wrappers)
 
     def addConsSOS2(self, vars, weights=None, name="SOS2cons",
                 initial=True, separate=True, enforce=True, check=True,
@@ -2303,23 +3464,27 @@ cdef class Model:
 
         """
         cdef SCIP_CONS* scip_cons
-        cdef int _nvars
-
-        PY_SCIP_CALL(SCIPcreateConsSOS2(self._scip, &scip_cons, str_conversion(name), 0, NULL, NULL,
-            initial, separate, enforce, check, propagate, local, dynamic, removable, stickingatnode))
+        cdef SCIP_VAR** _vars
+        cdef SCIP_Real* _weights
+        cdef int _nvars = len(vars)
 
-        if weights is None:
-            for v in vars:
-                var = <Variable>v
-                PY_SCIP_CALL(SCIPappendVarSOS2(self._scip, scip_cons, var.scip_var))
-        else:
-            nvars = len(vars)
-            for i in range(nvars):
-                var = <Variable>vars[i]
-                PY_SCIP_CALL(SCIPaddVarSOS2(self._scip, scip_cons, var.scip_var, weights[i]))
+        _vars = <SCIP_VAR**> self._getScratch(_nvars * (sizeof(SCIP_VAR*) + sizeof(SCIP_Real)))
+        _weights = <SCIP_Real*> &_vars[_nvars]
+        try:
+            for i, var in enumerate(vars):
+                _vars[i] = (<Variable>var).scip_var
+                if weights is not None:
+                    _weights[i] = weights[i]
+
+            # without weights, the variables are ordered as given
+            PY_SCIP_CALL(SCIPcreateConsSOS2(self._scip, &scip_cons, str_conversion(name), _nvars, _vars,
+                NULL if weights is None else _weights,
+                initial, separate, enforce, check, propagate, local, dynamic, removable, stickingatnode))
+        finally:
+            self._releaseScratch(_vars)
 
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        return Constraint.create(scip_cons)
+        return Constraint.create(scip_cons, self._wrappers)
 
     def addConsAnd(self, vars, resvar, name="ANDcons",
             initial=True, separate=True, enforce=True, check=True,
@@ -2344,20 +3509,21 @@ cdef class Model:
 
         nvars = len(vars)
 
-        _vars = <SCIP_VAR**> malloc(len(vars) * sizeof(SCIP_VAR*))
-        for idx, var in enumerate(vars):
-            _vars[idx] = (<Variable>var).scip_var
-        _resVar = (<Variable>resvar).scip_var
+        _vars = <SCIP_VAR**> self._getScratch(nvars * sizeof(SCIP_VAR*))
+        try:
+            for idx, var in enumerate(vars):
+                _vars[idx] = (<Variable>var).scip_var
+            _resVar = (<Variable>resvar).scip_var
 
-        PY_SCIP_CALL(SCIPcreateConsAnd(self._scip, &scip_cons, str_conversion(name), _resVar, nvars, _vars,
-            initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable, stickingatnode))
+            PY_SCIP_CALL(SCIPcreateConsAnd(self._scip, &scip_cons, str_conversion(name), _resVar, nvars, _vars,
+                initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable, stickingatnode))
+        finally:
+            self._releaseScratch(_vars)
 
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        pyCons = Constraint.create(scip_cons)
+        pyCons = Constraint.create(scip_cons, self._wrappers)
         PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
 
-        free(_vars)
-
         return pyCons
 
     def addConsOr(self, vars, resvar, name="ORcons",
@@ -2383,20 +3549,21 @@ cdef class Model:
 
         nvars = len(vars)
 
-        _vars = <SCIP_VAR**> malloc(len(vars) * sizeof(SCIP_VAR*))
-        for idx, var in enumerate(vars):
-            _vars[idx] = (<Variable>var).scip_var
-        _resVar = (<Variable>resvar).scip_var
+        _vars = <SCIP_VAR**> self._getScratch(nvars * sizeof(SCIP_VAR*))
+        try:
+            for idx, var in enumerate(vars):
+                _vars[idx] = (<Variable>var).scip_var
+            _resVar = (<Variable>resvar).scip_var
 
-        PY_SCIP_CALL(SCIPcreateConsOr(self._scip, &scip_cons, str_conversion(name), _resVar, nvars, _vars,
-            initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable, stickingatnode))
+            PY_SCIP_CALL(SCIPcreateConsOr(self._scip, &scip_cons, str_conversion(name), _resVar, nvars, _vars,
+                initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable, stickingatnode))
+        finally:
+            self._releaseScratch(_vars)
 
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        pyCons = Constraint.create(scip_cons)
+        pyCons = Constraint.create(scip_cons, self._wrappers)
         PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
 
-        free(_vars)
-
         return pyCons
 
     def addConsXor(self, vars, rhsvar, name="XORcons",
@@ -2423,19 +3590,20 @@ cdef class Model:
         nvars = len(vars)
 
         assert type(rhsvar) is type(bool()), "Provide BOOLEAN value as rhsvar, you gave %s." % type(rhsvar)
-        _vars = <SCIP_VAR**> malloc(len(vars) * sizeof(SCIP_VAR*))
-        for idx, var in enumerate(vars):
-            _vars[idx] = (<Variable>var).scip_var
+        _vars = <SCIP_VAR**> self._getScratch(nvars * sizeof(SCIP_VAR*))
+        try:
+            for idx, var in enumerate(vars):
+                _vars[idx] = (<Variable>var).scip_var
 
-        PY_SCIP_CALL(SCIPcreateConsXor(self._scip, &scip_cons, str_conversion(name), rhsvar, nvars, _vars,
-            initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable, stickingatnode))
+            PY_SCIP_CALL(SCIPcreateConsXor(self._scip, &scip_cons, str_conversion(name), rhsvar, nvars, _vars,
+                initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable, stickingatnode))
+        finally:
+            self._releaseScratch(_vars)
 
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        pyCons = Constraint.create(scip_cons)
+        pyCons = Constraint.create(scip_cons, self._wrappers)
         PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
 
-        free(_vars)
-
         return pyCons
 
     def addConsCardinality(self, consvars, cardval, indvars=None, weights=None, name="CardinalityCons",
@@ -2461,28 +3629,34 @@ cdef class Model:
 
         """
         cdef SCIP_CONS* scip_cons
-        cdef SCIP_VAR* indvar
-
-        PY_SCIP_CALL(SCIPcreateConsCardinality(self._scip, &scip_cons, str_conversion(name), 0, NULL, cardval, NULL, NULL,
-            initial, separate, enforce, check, propagate, local, dynamic, removable, stickingatnode))
+        cdef SCIP_VAR** _vars
+        cdef SCIP_VAR** _indvars
+        cdef SCIP_Real* _weights
+        cdef int _nvars = len(consvars)
 
         # circumvent an annoying bug in SCIP 4.0.0 that does not allow uninitialized weights
         if weights is None:
-            weights = list(range(1, len(consvars) + 1))
+            weights = list(range(1, _nvars + 1))
 
-        for i, v in enumerate(consvars):
-            var = <Variable>v
-            if indvars:
-                indvar = (<Variable>indvars[i]).scip_var
-            else:
-                indvar = NULL
-            if weights is None:
-                PY_SCIP_CALL(SCIPappendVarCardinality(self._scip, scip_cons, var.scip_var, indvar))
-            else:
-                PY_SCIP_CALL(SCIPaddVarCardinality(self._scip, scip_cons, var.scip_var, indvar, <SCIP_Real>weights[i]))
+        _vars = <SCIP_VAR**> self._getScratch(_nvars * (2 * sizeof(SCIP_VAR*) + sizeof(SCIP_Real)))
+        _indvars = &_vars[_nvars]
+        _weights = <SCIP_Real*> &_indvars[_nvars]
+        try:
+            for i, v in enumerate(consvars):
+                _vars[i] = (<Variable>v).scip_var
+                if indvars:
+                    _indvars[i] = (<Variable>indvars[i]).scip_var
+                _weights[i] = <SCIP_Real>weights[i]
+
+            # without indicator variables, new ones are introduced automatically
+            PY_SCIP_CALL(SCIPcreateConsCardinality(self._scip, &scip_cons, str_conversion(name), _nvars, _vars, cardval,
+                _indvars if indvars else NULL, _weights,
+                initial, separate, enforce, check, propagate, local, dynamic, removable, stickingatnode))
+        finally:
+            self._releaseScratch(_vars)
 
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        pyCons = Constraint.create(scip_cons)
+        pyCons = Constraint.create(scip_cons, self._wrappers)
 
         PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
 
@@ -2542,7 +3716,7 @@ cdef class Model:
             PY_SCIP_CALL(SCIPaddVarIndicator(self._scip, scip_cons, var.scip_var, <SCIP_Real>coeff))
 
         PY_SCIP_CALL(SCIPaddCons(self._scip, scip_cons))
-        pyCons = Constraint.create(scip_cons)
+        pyCons = Constraint.create(scip_cons, self._wrappers)
 
         PY_SCIP_CALL(SCIPreleaseCons(self._scip, &scip_cons))
 
@@ -2779,7 +3953,7 @@ cdef class Model:
         """
         cdef SCIP_CONS* transcons
         PY_SCIP_CALL(SCIPgetTransformedCons(self._scip, cons.scip_cons, &transcons))
-        return Constraint.create(transcons)
+        return Constraint.create(transcons, self._wrappers)
 
     def isNLPConstructed(self):
         """returns whether SCIP's internal NLP has been constructed"""
@@ -2794,7 +3968,7 @@ cdef class Model:
         cdef SCIP_NLROW** nlrows
 
         nlrows = SCIPgetNLPNlRows(self._scip)
-        return [NLRow.create(nlrows[i]) for i in range(self.getNNlRows())]
+        return [NLRow.create(nlrows[i], self._wrappers) for i in range(self.getNNlRows())]
 
     def getNlRowSolActivity(self, NLRow nlrow, Solution sol = None):
         """gives the activity of a nonlinear row for a given primal solution
@@ -2859,8 +4033,8 @@ cdef class Model:
         _nbilinterms = SCIPgetNBilinTermsQuadratic(self._scip, cons.scip_cons)
 
         for i in range(_nbilinterms):
-            var1 = Variable.create(_bilinterms[i].var1)
-            var2 = Variable.create(_bilinterms[i].var2)
+            var1 = Variable.create(_bilinterms[i].var1, self._wrappers)
+            var2 = Variable.create(_bilinterms[i].var2, self._wrappers)
             bilinterms.append((var1,var2,_bilinterms[i].coef))
 
         # quadratic terms
@@ -2868,7 +4042,7 @@ cdef class Model:
         _nquadterms = SCIPgetNQuadVarTermsQuadratic(self._scip, cons.scip_cons)
 
         for i in range(_nquadterms):
-            var = Variable.create(_quadterms[i].var)
+            var = Variable.create(_quadterms[i].var, self._wrappers)
             quadterms.append((var,_quadterms[i].sqrcoef,_quadterms[i].lincoef))
 
         # linear terms
@@ -2877,7 +4051,7 @@ cdef class Model:
         _nlinvars = SCIPgetNLinearVarsQuadratic(self._scip, cons.scip_cons)
 
         for i in range(_nlinvars):
-            var = Variable.create(_linvars[i])
+            var = Variable.create(_linvars[i], self._wrappers)
             linterms.append((var,_lincoefs[i]))
 
         return (bilinterms, quadterms, linterms)
@@ -2886,6 +4060,63 @@ cdef class Model:
         """sets the value of the given variable in the global relaxation solution"""
         PY_SCIP_CALL(SCIPsetRelaxSolVal(self._scip, NULL, var.scip_var, val))
 
+    def setRelaxSolVals(self, vars_or_indices, values, includeslp=False, Relax relax=None):
+        """sets the values of the given variables in the global relaxation solution and informs SCIP about the validity
+        and whether the solution can be enforced via linear cuts
+
+        :param vars_or_indices: sequence of variables, or integer array of indices referring to the problem variables
+                                in the order of getVars(transformed=True)
+        :param values: array with the value of each variable
+        :param includeslp: does the relaxator contain all cuts in the LP? (Default value = False)
+        :param Relax relax: relaxator that sets the values, None for an unspecified source (Default value = None)
+
+        """
+        cdef double[::1] _values = np.ascontiguousarray(values, dtype=np.double)
+        cdef int[::1] _indices
+        cdef SCIP_VAR** _probvars
+        cdef SCIP_VAR** _vars
+        cdef SCIP_RELAX* _relax = NULL
+        cdef int nprobvars
+        cdef int nvars = len(vars_or_indices)
+        cdef int i
+
+        if _values.shape[0] != nvars:
+            raise ValueError("expected %d values, got %d" % (nvars, _values.shape[0]))
+
+        if relax is not None:
+            _relax = SCIPfindRelax(self._scip, str_conversion(relax.name))
+
+        _vars = <SCIP_VAR**> malloc(max(nvars, 1) * sizeof(SCIP_VAR*))
+        try:
+            indices = np.asarray(vars_or_indices)
+            if indices.dtype.kind in 'iu':
+                _indices = np.ascontiguousarray(indices, dtype=np.intc)
+                _probvars = SCIPgetVars(self._scip)
+                nprobvars = SCIPgetNVars(self._scip)
+                for i in range(nvars):
+                    if _indices[i] < 0 or _indices[i] >= nprobvars:
+                        raise IndexError("variable index %d out of range" % _indices[i])
+                    _vars[i] = _probvars[_indices[i]]
+            else:
+                for i, var in enumerate(vars_or_indices):
+                    _vars[i] = (<Variable?>var).scip_var
+
+            PY_SCIP_CALL(SCIPsetRelaxSolVals(self._scip, _relax, nvars, _vars, &_values[0] if nvars > 0 else NULL, includeslp))
+        finally:
+            free(_vars)
+
+    def markRelaxSolValid(self, includeslp=False, Relax relax=None):
+        """informs SCIP that the relaxation solution is valid and whether the relaxation can be enforced through linear cuts
+
+        :param includeslp: does the relaxator contain all cuts in the LP? (Default value = False)
+        :param Relax relax: relaxator that set the solution, None for an unspecified source (Default value = None)
+
+        """
+        cdef SCIP_RELAX* _relax = NULL
+        if relax is not None:
+            _relax = SCIPfindRelax(self._scip, str_conversion(relax.name))
+        PY_SCIP_CALL(SCIPmarkRelaxSolValid(self._scip, _relax, includeslp))
+
     def getConss(self):
         """Retrieve all constraints."""
         cdef SCIP_CONS** _conss
@@ -2894,7 +4125,21 @@ cdef class Model:
 
         _conss = SCIPgetConss(self._scip)
         _nconss = SCIPgetNConss(self._scip)
-        return [Constraint.create(_conss[i]) for i in range(_nconss)]
+        return [Constraint.create(_conss[i], self._wrappers) for i in range(_nconss)]
+
+    def getConsByName(self, name):
+        """Retrieve a constraint by its name.
+
+        In the problem stage this finds the original constraints, afterwards the transformed ones.
+
+        :param name: name of the constraint
+        :return: the constraint, or None if there is no constraint of that name
+
+        """
+        cdef SCIP_CONS* _cons = SCIPfindCons(self._scip, str_conversion(name))
+        if _cons == NULL:
+            return None
+        return Constraint.create(_cons, self._wrappers)
 
     def getNConss(self):
         """Retrieve number of all constraints"""
@@ -2907,6 +4152,9 @@ cdef class Model:
 
         """
         PY_SCIP_CALL(SCIPdelCons(self._scip, cons.scip_cons))
+        # SCIP may free the constraint and reuse its address
+        self._wrappers.origconss.pop(<size_t>cons.scip_cons, None)
+        self._wrappers.conss.pop(<size_t>cons.scip_cons, None)
 
     def delConsLocal(self, Constraint cons):
         """Delete constraint from the current node and it's children
@@ -2937,6 +4185,43 @@ cdef class Model:
             valsdict[bytes(SCIPvarGetName(_vars[i])).decode('utf-8')] = _vals[i]
         return valsdict
 
+    def getValsLinearArray(self, Constraint cons, indices=False):
+        """Retrieve the variables and coefficients of a linear constraint as arrays.
+
+        :param Constraint cons: linear constraint to get the coefficients of
+        :param indices: return the indices of the variables in the order of getVars(transformed=True) instead of the variables;
+                        the indices of the variables of an original constraint refer to the order of getVars() instead,
+                        and variables that are not active give -1 (Default value = False)
+        :return: tuple (vars, coefs) of a list of variables, or a numpy int array of their indices, and a numpy array of coefficients
+
+        """
+        cdef SCIP_Real* _vals
+        cdef SCIP_VAR** _vars
+        cdef int[::1] _varindices
+        cdef int nvars
+        cdef int i
+
+        if SCIPconsGetHdlr(cons.scip_cons) != SCIPfindConshdlr(self._scip, "linear"):
+            constype = bytes(SCIPconshdlrGetName(SCIPconsGetHdlr(cons.scip_cons))).decode('UTF-8')
+            raise Warning("coefficients not available for constraints of type ", constype)
+
+        _vals = SCIPgetValsLinear(self._scip, cons.scip_cons)
+        _vars = SCIPgetVarsLinear(self._scip, cons.scip_cons)
+        nvars = SCIPgetNVarsLinear(self._scip, cons.scip_cons)
+
+        coefs = np.empty(nvars, dtype=np.double)
+        cdef double[::1] _coefs = coefs
+        for i in range(nvars):
+            _coefs[i] = _vals[i]
+
+        if indices:
+            varindices = np.empty(nvars, dtype=np.intc)
+            _varindices = varindices
+            for i in range(nvars):
+                _varindices[i] = SCIPvarGetProbindex(_vars[i])
+            return varindices, coefs
+        return [Variable.create(_vars[i], self._wrappers) for i in range(nvars)], coefs
+
     def getDualsolLinear(self, Constraint cons):
         """Retrieve the dual solution to a linear constraint.
 
@@ -2952,6 +4237,33 @@ cdef class Model:
             transcons = cons
         return SCIPgetDualsolLinear(self._scip, transcons.scip_cons)
 
+    def getDualsolLinearArray(self, conss):
+        """Retrieve the dual solutions of several linear constraints at once.
+
+        :param conss: sequence of linear constraints
+        :return: numpy array holding the dual solution value of each constraint
+
+        """
+        cdef SCIP_CONSHDLR* linconshdlr = SCIPfindConshdlr(self._scip, "linear")
+        cdef SCIP_CONS* scip_cons
+        cdef SCIP_CONS* transcons
+        cdef int i
+
+        duals = np.empty(len(conss), dtype=np.double)
+        cdef double[::1] _duals = duals
+
+        for i, cons in enumerate(conss):
+            scip_cons = (<Constraint?>cons).scip_cons
+            if SCIPconsGetHdlr(scip_cons) != linconshdlr:
+                constype = bytes(SCIPconshdlrGetName(SCIPconsGetHdlr(scip_cons))).decode('UTF-8')
+                raise Warning("dual solution values not available for constraints of type ", constype)
+            if SCIPconsIsOriginal(scip_cons):
+                PY_SCIP_CALL(SCIPgetTransformedCons(self._scip, scip_cons, &transcons))
+                scip_cons = transcons
+            _duals[i] = SCIPgetDualsolLinear(self._scip, scip_cons)
+
+        return duals
+
     def getDualMultiplier(self, Constraint cons):
         """DEPRECATED: Retrieve the dual solution to a linear constraint.
 
@@ -3224,13 +4536,15 @@ cdef class Model:
 
         if probnumber == -1:
             PY_SCIP_CALL(SCIPgetBendersMasterVar(self._scip, _benders, var.scip_var, &_mappedvar))
+            wrappers = self._wrappers
         else:
             PY_SCIP_CALL(SCIPgetBendersSubproblemVar(self._scip, _benders, var.scip_var, &_mappedvar, probnumber))
+            wrappers = _wrappersof(SCIPbendersSubproblem(_benders, probnumber))
 
         if _mappedvar == NULL:
             mappedvar = None
         else:
-            mappedvar = Variable.create(_mappedvar)
+            mappedvar = Variable.create(_mappedvar, wrappers)
 
         return mappedvar
 
@@ -3250,7 +4564,7 @@ cdef class Model:
             _benders = benders._benders
 
         _auxvar = SCIPbendersGetAuxiliaryVar(_benders, probnumber)
-        auxvar = Variable.create(_auxvar)
+        auxvar = Variable.create(_auxvar, self._wrappers)
 
         return auxvar
 
@@ -3400,6 +4714,11 @@ cdef class Model:
         constraint = Constraint()
         PY_SCIP_CALL(SCIPcreateCons(self._scip, &(constraint.scip_cons), n, scip_conshdlr, <SCIP_CONSDATA*>constraint,
                                 initial, separate, enforce, check, propagate, local, modifiable, dynamic, removable, stickingatnode))
+        constraint._cache = self._wrappers
+        if SCIPconsIsOriginal(constraint.scip_cons):
+            self._wrappers.origconss[<size_t>constraint.scip_cons] = constraint
+        else:
+            self._wrappers.conss[<size_t>constraint.scip_cons] = constraint
         return constraint
 
     def includePresol(self, Presol presol, name, desc, priority, maxrounds, timing=SCIP_PRESOLTIMING_FAST):
@@ -3648,7 +4967,7 @@ cdef class Model:
         PY_SCIP_CALL(SCIPgetLPBranchCands(self._scip, &lpcands, &lpcandssol, &lpcandsfrac,
                                           &nlpcands, &npriolpcands, &nfracimplvars))
 
-        return ([Variable.create(lpcands[i]) for i in range(nlpcands)], [lpcandssol[i] for i in range(nlpcands)],
+        return ([Variable.create(lpcands[i], self._wrappers) for i in range(nlpcands)], [lpcandssol[i] for i in range(nlpcands)],
                 [lpcandsfrac[i] for i in range(nlpcands)], nlpcands, npriolpcands, nfracimplvars)
 
 
@@ -3665,7 +4984,7 @@ cdef class Model:
         cdef SCIP_NODE* upchild
 
         PY_SCIP_CALL(SCIPbranchVar(self._scip, (<Variable>variable).scip_var, &downchild, &eqchild, &upchild))
-        return Node.create(downchild), Node.create(eqchild), Node.create(upchild)
+        return Node.create(downchild, self._wrappers), Node.create(eqchild, self._wrappers), Node.create(upchild, self._wrappers)
 
 
     def branchVarVal(self, variable, value):
@@ -3683,7 +5002,7 @@ cdef class Model:
 
         PY_SCIP_CALL(SCIPbranchVarVal(self._scip, (<Variable>variable).scip_var, value, &downchild, &eqchild, &upchild))
 
-        return Node.create(downchild), Node.create(eqchild), Node.create(upchild)
+        return Node.create(downchild, self._wrappers), Node.create(eqchild, self._wrappers), Node.create(upchild, self._wrappers)
 
     def calcNodeselPriority(self, Variable variable, branchdir, targetvalue):
         """calculates the node selection priority for moving the given variable's LP value
@@ -3720,7 +5039,7 @@ cdef class Model:
         """
         cdef SCIP_NODE* child
         PY_SCIP_CALL(SCIPcreateChild(self._scip, &child, nodeselprio, estimate))
-        return Node.create(child)
+        return Node.create(child, self._wrappers)
 
     # Diving methods (Diving is LP related)
     def startDive(self):
@@ -4067,6 +5386,55 @@ cdef class Model:
             PY_SCIP_CALL(SCIPaddSol(self._scip, solution.sol, &stored))
         return stored
 
+    def trySolArray(self, values, vars=None, Heur heur=None, printreason=False, completely=False, checkbounds=True, checkintegrality=True, checklprows=True):
+        """Create a primal solution from an array of values, check it for feasibility and try to add it to the storage.
+
+        :param values: array with the value of each variable in vars
+        :param vars: variables the values refer to; None uses the problem variables in the order of getVars(transformed=True) (Default value = None)
+        :param Heur heur: heuristic that found the solution (Default value = None)
+        :param printreason: should all reasons of violations be printed? (Default value = False)
+        :param completely: should all violation be checked? (Default value = False)
+        :param checkbounds: should the bounds of the variables be checked? (Default value = True)
+        :param checkintegrality: has integrality to be checked? (Default value = True)
+        :param checklprows: have current LP rows (both local and global) to be checked? (Default value = True)
+        :return: whether the solution was stored
+
+        """
+        values = np.asarray(values, dtype=np.double)
+        if values.ndim != 1:
+            raise ValueError("values must be a one-dimensional array")
+        return bool(self.trySolsArray(values[np.newaxis, :], vars, heur, printreason, completely, checkbounds, checkintegrality, checklprows)[0])
+
+    def trySolsArray(self, values, vars=None, Heur heur=None, printreason=False, completely=False, checkbounds=True, checkintegrality=True, checklprows=True):
+        """Create primal solutions from the rows of a matrix, check them for feasibility and try to add them to the storage.
+
+        :param values: two-dimensional array with one candidate solution per row and one column per variable in vars
+        :param vars: variables the columns refer to; None uses the problem variables in the order of getVars(transformed=True) (Default value = None)
+        :param Heur heur: heuristic that found the solutions (Default value = None)
+        :param printreason: should all reasons of violations be printed? (Default value = False)
+        :param completely: should all violation be checked? (Default value = False)
+        :param checkbounds: should the bounds of the variables be checked? (Default value = True)
+        :param checkintegrality: has integrality to be checked? (Default value = True)
+        :param checklprows: have current LP rows (both local and global) to be checked? (Default value = True)
+        :return: boolean numpy array indicating for each row whether the solution was stored
+
+        """
+        return _submitSolsArray(self, values, vars, heur, False, printreason, completely, checkbounds, checkintegrality, checklprows)
+
+    def addSolArray(self, values, vars=None, Heur heur=None):
+        """Create a primal solution from an array of values and try to add it to the storage without checking feasibility.
+
+        :param values: array with the value of each variable in vars
+        :param vars: variables the values refer to; None uses the problem variables in the order of getVars(transformed=True) (Default value = None)
+        :param Heur heur: heuristic that found the solution (Default value = None)
+        :return: whether the solution was stored
+
+        """
+        values = np.asarray(values, dtype=np.double)
+        if values.ndim != 1:
+            raise ValueError("values must be a one-dimensional array")
+        return bool(_submitSolsArray(self, values[np.newaxis, :], vars, heur, True, False, False, False, False, False)[0])
+
     def freeSol(self, Solution solution):
         """Free given solution
 
@@ -4136,6 +5504,69 @@ cdef class Model:
         else:
             return expr._evaluate(sol)
 
+    def evaluate(self, exprs, sols=None):
+        """Evaluate expressions in several solutions at once.
+
+        Each expression is compiled once into a flat tape of instructions, which is then evaluated for all solutions.
+
+        :param exprs: Expr or GenExpr, or a sequence of them; variables are expressions as well
+        :param sols: Solution, or a sequence of solutions, where None stands for the LP/pseudo solution;
+                     None uses all solutions in the solution storage (Default value = None)
+        :return: numpy array of shape (len(exprs), len(sols)), or of shape (len(sols),) if a single expression is given
+
+        """
+        cdef Solution sol
+        cdef double* stack
+        cdef double[:, ::1] _values
+        cdef double[:, ::1] _result
+        cdef int nvars
+        cdef int nsols
+        cdef int i
+        cdef int j
+
+        single = isinstance(exprs, (Expr, GenExpr))
+        if single:
+            exprs = [exprs]
+        if sols is None:
+            sols = self.getSols()
+        elif isinstance(sols, Solution):
+            sols = [sols]
+
+        varindex = {}
+        variables = []
+        tapes = []
+        maxdepth = 1
+        for expr in exprs:
+            tape, depth = _compile_tape(expr, varindex, variables)
+            tapes.append(tape)
+            maxdepth = max(maxdepth, depth)
+
+        # values of all variables involved, one column per solution
+        nvars = len(variables)
+        nsols = len(sols)
+        values = np.empty((nvars, nsols), dtype=np.double)
+        _values = values
+        for j, s in enumerate(sols):
+            sol = Solution.create(self._scip, NULL) if s is None else s
+            for i in range(nvars):
+                _values[i, j] = SCIPgetSolVal(self._scip, sol.sol, (<Variable>variables[i]).scip_var)
+
+        result = np.empty((len(tapes), nsols), dtype=np.double)
+        _result = result
+        stack = <double*> malloc(maxdepth * sizeof(double))
+        if stack == NULL:
+            raise MemoryError()
+        try:
+            for i, (ops, args, vals) in enumerate(tapes):
+                for j in range(nsols):
+                    _result[i, j] = _run_tape(ops, args, vals, _values, j, stack)
+        finally:
+            free(stack)
+
+        if single:
+            return result[0]
+        return result
+
     def getVal(self, Expr expr):
         """Retrieve the value of the given variable or expression in the best known solution.
         Can only be called after solving is completed.
@@ -4513,6 +5944,8 @@ cdef class Model:
 
         """
         absfile = str_conversion(abspath(filename))
+        self._wrappers._free()
+        self._wrappers = _newwrappers(self._scip)
         if extension is None:
             PY_SCIP_CALL(SCIPreadProb(self._scip, absfile, NULL))
         else:
@@ -4541,6 +5974,7 @@ cdef class Model:
 
     def freeReoptSolve(self):
         """Frees all solution process data and prepares for reoptimization"""
+        self._wrappers._freeTransformed()
         PY_SCIP_CALL(SCIPfreeReoptSolve(self._scip))
 
     def chgReoptObjective(self, coeffs, sense = 'minimize'):
@@ -4599,6 +6033,102 @@ cdef class Model:
         assert isinstance(var, Variable), "The given variable is not a pyvar, but %s" % var.__class__.__name__
         PY_SCIP_CALL(SCIPchgVarBranchPriority(self._scip, var.scip_var, priority))
 
+cdef _submitSolsArray(Model model, values, vars, Heur heur, SCIP_Bool add, SCIP_Bool printreason, SCIP_Bool completely,
+                      SCIP_Bool checkbounds, SCIP_Bool checkintegrality, SCIP_Bool checklprows):
+    """fills one SCIP solution per row of values via SCIPsetSolVals and tries (or, if add is set, adds) each of them"""
+    cdef SCIP* scip = model._scip
+    cdef double[:, ::1] _values = np.ascontiguousarray(values, dtype=np.double)
+    cdef int nsols = _values.shape[0]
+    cdef SCIP_VAR** _vars
+    cdef SCIP_HEUR* _heur = NULL
+    cdef SCIP_SOL* _sol = NULL
+    cdef SCIP_Bool stored
+    cdef int nvars
+    cdef int i
+
+    accepted = np.zeros(nsols, dtype=bool)
+
+    if vars is None:
+        _vars = SCIPgetVars(scip)
+        nvars = SCIPgetNVars(scip)
+    else:
+        nvars = len(vars)
+        _vars = <SCIP_VAR**> malloc(max(nvars, 1) * sizeof(SCIP_VAR*))
+        if _vars == NULL:
+            raise MemoryError()
+
+    try:
+        if vars is not None:
+            for i, var in enumerate(vars):
+                _vars[i] = (<Variable?>var).scip_var
+
+        if _values.shape[1] != nvars:
+            raise ValueError("expected %d values per solution, got %d" % (nvars, _values.shape[1]))
+
+        if heur is not None:
+            _heur = SCIPfindHeur(scip, str_conversion(heur.name))
+
+        # the same solution is refilled for every row; SCIPtrySol() and SCIPaddSol() store a copy
+        PY_SCIP_CALL(SCIPcreateSol(scip, &_sol, _heur))
+        for i in range(nsols):
+            if nvars > 0:
+                PY_SCIP_CALL(SCIPsetSolVals(scip, _sol, nvars, _vars, &_values[i, 0]))
+            if add:
+                PY_SCIP_CALL(SCIPaddSol(scip, _sol, &stored))
+            else:
+                PY_SCIP_CALL(SCIPtrySol(scip, _sol, printreason, completely, checkbounds, checkintegrality, checklprows, &stored))
+            accepted[i] = stored
+    finally:
+        if _sol != NULL:
+            PY_SCIP_CALL(SCIPfreeSol(scip, &_sol))
+        if vars is not None:
+            free(_vars)
+
+    return accepted
+
+def _coo_arrays(Q):
+    """returns the (row, col, data) arrays of a matrix given in coordinate format, as a scipy.sparse matrix or as a dense array"""
+    if isinstance(Q, tuple):
+        row, col, data = Q
+    elif hasattr(Q, "row") and hasattr(Q, "col") and hasattr(Q, "data"):
+        row, col, data = Q.row, Q.col, Q.data
+    elif hasattr(Q, "tocoo"):
+        Q = Q.tocoo()
+        row, col, data = Q.row, Q.col, Q.data
+    else:
+        Q = np.asarray(Q, dtype=np.double)
+        if Q.ndim != 2:
+            raise ValueError("Q must be given in coordinate format or as a matrix")
+        row, col = np.nonzero(Q)
+        data = Q[row, col]
+    return (np.ascontiguousarray(row, dtype=np.intc), np.ascontiguousarray(col, dtype=np.intc),
+            np.ascontiguousarray(data, dtype=np.double))
+
+cdef enum:
+    _BOUNDSCOPE_ORIG
+    _BOUNDSCOPE_GLOBAL
+    _BOUNDSCOPE_LOCAL
+    _BOUNDSCOPE_NODE
+    _BOUNDSCOPE_DIVE
+    _BOUNDSCOPE_PROBING
+
+_BOUNDSCOPES = {'orig': _BOUNDSCOPE_ORIG, 'global': _BOUNDSCOPE_GLOBAL, 'local': _BOUNDSCOPE_LOCAL,
+                'node': _BOUNDSCOPE_NODE, 'dive': _BOUNDSCOPE_DIVE, 'probing': _BOUNDSCOPE_PROBING}
+
+cdef _chgVarBound(SCIP* scip, int scope, SCIP_NODE* node, SCIP_VAR* var, SCIP_Real bound, SCIP_Bool upper):
+    """changes a lower or upper bound of a variable in the given scope of Model.chgVarBounds()"""
+    if scope == _BOUNDSCOPE_GLOBAL:
+        PY_SCIP_CALL(SCIPchgVarUbGlobal(scip, var, bound) if upper else SCIPchgVarLbGlobal(scip, var, bound))
+    elif scope == _BOUNDSCOPE_NODE:
+        PY_SCIP_CALL(SCIPchgVarUbNode(scip, node, var, bound) if upper else SCIPchgVarLbNode(scip, node, var, bound))
+    elif scope == _BOUNDSCOPE_DIVE:
+        PY_SCIP_CALL(SCIPchgVarUbDive(scip, var, bound) if upper else SCIPchgVarLbDive(scip, var, bound))
+    elif scope == _BOUNDSCOPE_PROBING:
+        PY_SCIP_CALL(SCIPchgVarUbProbing(scip, var, bound) if upper else SCIPchgVarLbProbing(scip, var, bound))
+    else:
+        # in the problem stage, these change the bounds of the original problem
+        PY_SCIP_CALL(SCIPchgVarUb(scip, var, bound) if upper else SCIPchgVarLb(scip, var, bound))
+
 # debugging memory management
 def is_memory_freed():
     return BMSgetMemoryUsed() == 0
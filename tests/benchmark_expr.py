@@ -0,0 +1,42 @@
+##@file benchmark_expr.py
+#@brief measures the cost of building expressions with operator overloading
+"""
+Run with `python tests/benchmark_expr.py [nterms]`; this is not collected by pytest.
+
+Reports the time per operation for `x + y`, `2*x` and `x*y`, and the time per term of
+quicksum() over a linear and a nonlinear sum of nterms terms (default 10^6).
+"""
+import sys
+import timeit
+
+from pyscipopt import Model, quicksum, exp
+
+
+def per_operation(stmt, env, number):
+    '''best time of a statement over a few repetitions, in microseconds per execution'''
+    best = min(timeit.repeat(stmt, globals=env, number=number, repeat=5))
+    return 1e6 * best / number
+
+
+def main(nterms=10**6):
+    m = Model()
+    x = m.addVar("x")
+    y = m.addVar("y")
+    variables = [m.addVar() for _ in range(1000)]
+    env = dict(x=x, y=y, variables=variables, nterms=nterms, quicksum=quicksum, exp=exp)
+
+    print("%-40s %10s" % ("operation", "us/op"))
+    for stmt in ["x + y", "2*x", "x*2.0", "x*y", "x + 1", "x <= 1"]:
+        print("%-40s %10.3f" % (stmt, per_operation(stmt, env, 100000)))
+
+    print("%-40s %10s" % ("quicksum over %d terms" % nterms, "us/term"))
+    stmt = "quicksum(variables[i % 1000] for i in range(nterms))"
+    print("%-40s %10.3f" % ("linear", per_operation(stmt, env, 1) / nterms))
+    stmt = "quicksum(2.0*variables[i % 1000] for i in range(nterms))"
+    print("%-40s %10.3f" % ("linear with coefficients", per_operation(stmt, env, 1) / nterms))
+    stmt = "quicksum(exp(variables[i % 1000]) for i in range(nterms // 10))"
+    print("%-40s %10.3f" % ("nonlinear (nterms/10)", per_operation(stmt, env, 1) / (nterms // 10)))
+
+
+if __name__ == "__main__":
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 10**6)
@@ -0,0 +1,60 @@
+from pyscipopt import Model, Sepa, SCIP_RESULT, SCIP_PARAMSETTING
+
+class ArraySepa(Sepa):
+
+    def __init__(self):
+        self.counts = []
+        self.rejected = []
+
+    def sepaexeclp(self):
+        scip = self.model
+        x, y = scip.getVars(transformed=True)
+
+        # two cuts in CSR format: x + y <= 1 (violated by the LP optimum) and x <= 1 (never violated)
+        indptr = [0, 2, 3]
+        indices = [0, 1, 0]
+        coefs = [1.0, 1.0, 1.0]
+        lhs = -float("inf")
+        rhs = [1.0, 1.0]
+
+        # invalid input is rejected before any cut is created; exceptions raised here do not reach the test, so
+        # the outcomes are recorded and checked after optimize()
+        ncuts = scip.getNCuts()
+        for badptr, badindices in [([1, 2, 3], indices), ([0, 3, 2], indices), ([0, 2, 4], indices), (indptr, [0, 2, 0])]:
+            try:
+                scip.addCutsFromArrays(self, badptr, badindices, coefs, lhs, rhs, vars=[x, y])
+                rejected = False
+            except (ValueError, IndexError):
+                rejected = True
+            self.rejected.append(rejected and scip.getNCuts() == ncuts)
+
+        nadded, ninefficacious, infeasible = scip.addCutsFromArrays(self, indptr, indices, coefs, lhs, rhs, vars=[x, y])
+        self.counts.append((nadded, ninefficacious))
+
+        if infeasible:
+            return {"result": SCIP_RESULT.CUTOFF}
+        if nadded > 0:
+            return {"result": SCIP_RESULT.SEPARATED}
+        return {"result": SCIP_RESULT.DIDNOTFIND}
+
+def test_addCutsFromArrays():
+    s = Model()
+    s.hideOutput()
+    s.setPresolve(SCIP_PARAMSETTING.OFF)
+    s.setHeuristics(SCIP_PARAMSETTING.OFF)
+    s.setSeparating(SCIP_PARAMSETTING.OFF)
+
+    sepa = ArraySepa()
+    s.includeSepa(sepa, "python_arraysepa", "adds cuts from arrays", priority = 1000, freq = 1)
+
+    x = s.addVar("x", vtype="B", obj=-1.0)
+    y = s.addVar("y", vtype="B", obj=-1.0)
+    s.addCons(2*x + 2*y <= 3)
+
+    s.optimize()
+
+    assert sepa.counts
+    assert sepa.counts[0] == (1, 1)
+    assert sepa.rejected and all(sepa.rejected)
+    assert s.getObjVal() == -1.0
+    assert s.getNNodes() == 1
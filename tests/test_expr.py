@@ -1,7 +1,7 @@
 import pytest
 
 from pyscipopt import Model, sqrt, log, exp
-from pyscipopt.scip import Expr, GenExpr, ExprCons, Term, quicksum
+from pyscipopt.scip import Expr, GenExpr, ExprCons, Term, quicksum, _is_number
 
 @pytest.fixture(scope="module")
 def model():
@@ -116,6 +116,52 @@ def test_genexpr_op_genexpr(model):
     with pytest.raises(NotImplementedError):
         genexpr **= sqrt(2)
 
+def test_genexpr_inplace(model):
+    m, x, y, z = model
+    genexpr = exp(x) + sqrt(y)
+    alias = genexpr
+    genexpr += log(z)
+    genexpr += 2*x + 1
+    assert genexpr is alias
+    assert len(genexpr.children) == 4
+    assert genexpr.constant == 1.0
+
+    prodexpr = exp(x) * sqrt(y)
+    alias = prodexpr
+    prodexpr *= 3
+    prodexpr *= log(z)
+    assert prodexpr is alias
+    assert len(prodexpr.children) == 3
+    assert prodexpr.constant == 3.0
+
+    # the original expression is not modified when upgrading a polynomial
+    expr = x + y
+    upgraded = expr
+    upgraded += exp(z)
+    assert isinstance(expr, Expr)
+    assert isinstance(upgraded, GenExpr)
+
+def test_quicksum_genexpr(model):
+    m, x, y, z = model
+    n = 1000
+    terms = [exp(x) for _ in range(n)] + [x, y, 2*x, 5]
+    genexpr = quicksum(terms)
+    assert isinstance(genexpr, GenExpr)
+    # the polynomial part is merged into a single sum of its terms
+    assert len(genexpr.children) == n + 2
+    assert genexpr.constant == 5.0
+    assert isinstance(quicksum([x, y, 2]), Expr)
+
+def test_is_number(model):
+    import numpy as np
+    m, x, y, z = model
+    for number in [0, 1.5, True, 2**70, np.float64(1.0), np.int32(3), np.bool_(True), "2.5"]:
+        assert _is_number(number)
+    for other in [x, x + y, exp(x), x <= 1, "x", None, [1.0]]:
+        assert not _is_number(other)
+    assert isinstance(np.float64(2.0) * x, Expr)
+    assert isinstance(x + np.int64(1), Expr)
+
 def test_degree(model):
     m, x, y, z = model
     expr = GenExpr()
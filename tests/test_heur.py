@@ -25,6 +25,20 @@ class MyHeur(Heur):
         else:
             return {"result": SCIP_RESULT.DIDNOTFIND}
 
+class ArrayHeur(Heur):
+
+    def heurexec(self, heurtiming, nodeinfeasible):
+        vars = self.model.getVars(transformed=True)
+
+        # the first candidate violates x + 2*y >= 5, the second one is feasible
+        candidates = [[0.0, 0.0], [5.0, 0.0]]
+        self.accepted = self.model.trySolsArray(candidates, vars=vars, heur=self)
+
+        if self.accepted.any():
+            return {"result": SCIP_RESULT.FOUNDSOL}
+        else:
+            return {"result": SCIP_RESULT.DIDNOTFIND}
+
 def test_heur():
     # create solver instance
     s = Model()
@@ -48,6 +62,27 @@ def test_heur():
     assert round(sol[x]) == 5.0
     assert round(sol[y]) == 0.0
 
+def test_heur_array():
+    s = Model()
+    s.hideOutput()
+    heuristic = ArrayHeur()
+    s.includeHeur(heuristic, "PyArrayHeur", "custom heuristic submitting arrays", "Y", timingmask=SCIP_HEURTIMING.BEFORENODE)
+    s.setPresolve(SCIP_PARAMSETTING.OFF)
+
+    x = s.addVar("x", obj=1.0)
+    y = s.addVar("y", obj=2.0)
+    s.addCons(x + 2*y >= 5)
+
+    # a solution added in the problem stage is kept in the original space
+    assert s.addSolArray([10.0, 10.0], vars=[x, y])
+
+    s.optimize()
+
+    assert list(heuristic.accepted) == [False, True]
+    sol = s.getBestSol()
+    assert round(sol[x]) == 5.0
+    assert round(sol[y]) == 0.0
+
 def test_heur_memory():
     if is_optimized_mode():
        pytest.skip()
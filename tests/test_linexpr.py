@@ -1,7 +1,7 @@
 import pytest
 
 from pyscipopt import Model
-from pyscipopt.scip import Expr, ExprCons, Term, quicksum
+from pyscipopt.scip import Expr, ExprCons, GenExpr, Term, quicksum, setMaxPowerTerms
 
 @pytest.fixture(scope="module")
 def model():
@@ -18,6 +18,41 @@ def test_term(model):
     assert x[x] == 1.0
     assert x[y] == 0.0
 
+def test_term_interning(model):
+    import copy
+    m, x, y, z = model
+    assert Term(x, y) is Term(y, x)
+    assert Term() is CONST
+    assert copy.copy(Term(x, z)) is Term(z, x)
+    assert Term(x, y) != Term(x, z)
+    assert hash(Term(y, x)) == hash(tuple(sorted([x.ptr(), y.ptr()])))
+    # products reuse the interned terms
+    assert list((x*y).terms)[0] is Term(x, y)
+
+def test_term_reallocation():
+    s = Model()
+    x = s.addVar("x")
+    tx = Term(x)
+    del s
+    # a term of a freed variable is not reused for a new variable, even at the same address
+    for _ in range(10):
+        m = Model()
+        v = m.addVar("x")
+        assert Term(v) is not tx
+        assert Term(v).vartuple[0] is v
+        assert (2*v).terms == {Term(v): 2.0}
+
+def test_variable_terms():
+    m = Model()
+    m.addVar("a")
+    # variables created by getVars() build their terms on first use
+    a, = m.getVars()
+    assert a.terms == {Term(a): 1.0}
+    expr = 2 * a + 1
+    assert expr[a] == 2.0
+    assert expr[CONST] == 1.0
+    assert a.degree() == 1
+
 def test_operations_linear(model):
     m, x, y, z = model
     expr = x + y
@@ -86,6 +121,27 @@ def test_operations_quadratic(model):
     assert expr[CONST] == -1.0
     assert expr[Term(x,y)] == 1.0
 
+def test_product_terms(model):
+    m, x, y, z = model
+    expr = (x + 2*y + 1)*(3*x - y + z)
+    assert expr[Term(x,x)] == 3.0
+    assert expr[Term(x,y)] == 5.0
+    assert expr[Term(y,x)] == 5.0
+    assert expr[Term(x,z)] == 1.0
+    assert expr[Term(y,y)] == -2.0
+    assert expr[Term(y,z)] == 2.0
+    assert expr[x] == 3.0
+    assert expr[y] == -1.0
+    assert expr[z] == 1.0
+    assert len(expr.terms) == 9
+
+    # products of higher degree merge the variables of both terms
+    expr = (x*z + y)*(x*y + z)
+    assert expr.terms == (x*x*y*z + x*z*z + x*y*y + y*z).terms
+    for term in expr.terms:
+        assert term == Term(*term.vartuple)
+        assert hash(term) == hash(Term(*term.vartuple))
+
 def test_power_for_quadratic(model):
     m, x, y, z = model
     expr = x**2 + x + 1
@@ -98,6 +154,27 @@ def test_power_for_quadratic(model):
     assert (x**2).terms == (x*x).terms
     assert ((x + 3)**2).terms == (x**2 + 6*x + 9).terms
 
+def test_power_expansion(model):
+    m, x, y, z = model
+    base = 2*x - y + 3*z*x + 1
+    for n in range(1, 5):
+        product = Expr() + 1
+        for _ in range(n):
+            product = product * base
+        expanded = base**n
+        assert set(expanded.terms) == set(t for t, c in product.terms.items() if c != 0.0)
+        for term, coef in expanded.terms.items():
+            assert abs(coef - product[term]) <= 1e-9 * max(1.0, abs(coef))
+
+    # powers with too many terms are kept unexpanded
+    setMaxPowerTerms(10)
+    try:
+        assert isinstance((x + y + z)**2, Expr)
+        assert isinstance((x + y + z + 1)**3, GenExpr)
+    finally:
+        setMaxPowerTerms(None)
+    assert isinstance((x + y + z + 1)**3, Expr)
+
 def test_operations_poly(model):
     m, x, y, z = model
     expr = x*x*x + 2*y*y
@@ -204,6 +281,27 @@ def test_equation(model):
     assert equat.expr[y] == -3.0
     assert equat.expr[CONST] == 0.0
 
+def test_normalize_keeps_expression(model):
+    m, x, y, z = model
+    expr = x + 0*y + 2*z + 3
+    cons = expr <= 5
+    assert cons._rhs == 2.0
+    assert set(cons.expr.terms) == {Term(x), Term(z)}
+    # the expression given by the user is not modified
+    assert expr[CONST] == 3.0
+    assert Term(y) in expr.terms
+    assert cons.expr is not expr
+
+    # adding the other side keeps the normalized expression
+    ranged = cons >= 1
+    assert ranged._lhs == -2.0
+    assert ranged._rhs == 2.0
+    assert ranged.expr is cons.expr
+
+    ranged = 3 <= (x + 2*y + 1 <= 5)
+    assert ranged._lhs == 2.0
+    assert ranged._rhs == 4.0
+
 def test_objective(model):
     m, x, y, z = model
 
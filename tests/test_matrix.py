@@ -0,0 +1,107 @@
+import itertools
+
+import numpy as np
+import pytest
+
+from pyscipopt import Model, MatrixExpr
+from pyscipopt.scip import Term
+
+
+def test_matrix_assignment():
+    n = 4
+    cost = np.array([[4, 1, 3, 2],
+                     [2, 0, 5, 3],
+                     [3, 2, 2, 4],
+                     [1, 3, 4, 2]], dtype=float)
+
+    m = Model()
+    x = m.addMatrixVar((n, n), vtype='B', name='x')
+    assert x.shape == (n, n)
+    assert x[1, 2].name == 'x_1_2'
+
+    rows = m.addCons(x.sum(axis=1) == 1, name='row')
+    cols = m.addCons(x.sum(axis=0) == 1, name='col')
+    assert rows.shape == (n,)
+    assert cols[0].name == 'col_0'
+    m.setObjective((cost * x).sum())
+
+    m.optimize()
+
+    best = min(sum(cost[i, p[i]] for i in range(n)) for p in itertools.permutations(range(n)))
+    assert abs(m.getObjVal() - best) < 1e-6
+    for i in range(n):
+        assert sum(round(m.getVal(x[i, j])) for j in range(n)) == 1
+
+
+def test_matrix_operations():
+    m = Model()
+    x = m.addMatrixVar((2, 3), lb=-5, ub=np.array([1, 2, 3]))
+    y = m.addMatrixVar(3)
+    z = m.addVar("z")
+
+    assert x[0, 2].getUbGlobal() == 3
+    assert x[1, 0].getLbGlobal() == -5
+
+    A = np.array([[1.0, 0.0, 2.0], [0.0, 3.0, 0.0]])
+    expr = A @ y
+    assert isinstance(expr, MatrixExpr)
+    assert expr.shape == (2,)
+    assert list(expr.indptr) == [0, 2, 3]
+    assert list(expr.data) == [1.0, 2.0, 3.0]
+    assert list(expr.indices) == [y[0].ptr(), y[2].ptr(), y[1].ptr()]
+
+    # broadcasting a row vector, a scalar variable and a constant over the rows of x
+    expr = 2*x - y + z + 1
+    assert expr.shape == (2, 3)
+    single = expr[1, 2].toExpr()
+    assert single[x[1, 2]] == 2.0
+    assert single[y[2]] == -1.0
+    assert single[z] == 1.0
+    assert single[Term()] == 1.0
+
+    assert (x @ np.ones(3)).shape == (2,)
+    assert x.sum().shape == ()
+    with pytest.raises(NotImplementedError):
+        x * x
+
+
+def test_matrix_constraints():
+    m = Model()
+    x = m.addMatrixVar(3, ub=10)
+    A = np.array([[1.0, 1.0, 1.0], [1.0, -1.0, 0.0]])
+
+    conss = m.addCons(np.array([2.0, -1.0]) <= (A @ x + 1 <= np.array([7.0, 0.0])))
+    assert conss.shape == (2,)
+    assert m.getNConss() == 2
+    m.setObjective(x.sum(), sense='maximize')
+
+    m.optimize()
+
+    assert abs(m.getObjVal() - 6.0) < 1e-6
+    assert m.getVal(x[0]) - m.getVal(x[1]) <= -1.0 + 1e-6
+
+
+def test_matrix_models():
+    m = Model()
+    x = m.addMatrixVar(3)
+    other = Model()
+    y = other.addMatrixVar(3)
+
+    # matrix expressions only refer to the variables of the problem they were built on
+    with pytest.raises(ValueError):
+        other.addCons(x.sum() <= 1)
+    with pytest.raises(ValueError):
+        x + y
+
+    expr = 2 * x[:1] + 1
+    m.freeProb()
+    with pytest.raises(ValueError):
+        expr.toExpr()
+    with pytest.raises(ValueError):
+        m.addCons(expr <= 1)
+
+if __name__ == "__main__":
+    test_matrix_assignment()
+    test_matrix_operations()
+    test_matrix_constraints()
+    test_matrix_models()
@@ -1,6 +1,6 @@
 import pytest
 
-from pyscipopt import Model
+from pyscipopt import Model, quicksum, SCIP_PARAMSETTING
 
 def test_model():
     # create solver instance
@@ -92,6 +92,146 @@ def test_model_ptr():
         Model.from_ptr("some gibberish", take_ownership=False)
 
 
+def test_wrapper_interning():
+    s = Model()
+    s.hideOutput()
+    x = s.addVar("x", vtype = 'I', ub = 5.0)
+    c = s.addCons(x <= 3.5)
+    s.setObjective(-x)
+    s.optimize()
+
+    # repeated queries return the same wrapper objects
+    assert s.getConss()[0] is c
+    assert s.getConss()[0] is s.getConss()[0]
+    assert s.getTransformedCons(c) is s.getTransformedCons(c)
+    tx = s.getTransformedVar(x)
+    assert s.getTransformedVar(x) is tx
+    assert s.getVars(transformed=True)[0] is tx
+
+def test_wrapper_reallocation():
+    s = Model()
+    s.hideOutput()
+    x = s.addVar("x", ub = 5.0)
+
+    # a deleted constraint's wrapper is not reused for a new constraint, even at the same address
+    c = s.addCons(x <= 1)
+    c.data = "deleted"
+    s.delCons(c)
+    for _ in range(10):
+        d = s.addCons(x <= 2)
+        assert d is not c
+        assert d.data is None
+
+    y = s.addVar("y")
+    y.data = "deleted"
+    assert s.delVar(y)
+    for _ in range(10):
+        z = s.addVar()
+        assert z is not y
+        assert z.data is None
+
+    # wrappers of the transformed problem do not survive freeTransform()
+    s.setObjective(-x)
+    s.optimize()
+    tx = s.getTransformedVar(x)
+    tx.data = "freed"
+    s.freeTransform()
+    s.optimize()
+    assert s.getTransformedVar(x).data is None
+
+    # nor do wrappers of a freed model
+    x.data = "freed"
+    del s
+    for _ in range(10):
+        m = Model()
+        v = m.addVar("x")
+        assert v is not x
+        assert v.data is None
+
+def test_scratch_memory_released_on_error():
+    m = Model()
+    x = [m.addVar(vtype = 'B') for _ in range(3)]
+
+    # the weights are too short; the temporary arrays must still be given back
+    with pytest.raises(IndexError):
+        m.addConsCardinality(x, 1, weights = [1.0])
+    assert not m._scratchused
+
+    m.addConsCardinality(x, 1, weights = [1.0, 2.0, 3.0])
+    m.addConsSOS1(x)
+    m.addConsAnd(x[:2], x[2])
+    m.addCons(quicksum(x) <= 2)
+    assert m.getNConss() == 4
+    assert not m._scratchused
+
+def test_addConss():
+    m = Model()
+    m.hideOutput()
+    x = [m.addVar(ub = 10.0) for _ in range(5)]
+
+    def conss():
+        for i in range(4):
+            yield x[i] + x[i+1] <= 3
+        yield x[0] * x[1] <= 2
+        yield x[4] >= 1
+
+    # small chunks to exercise the staging buffer
+    assert m.addConss(conss(), chunksize = 3) == 6
+    assert m.getNConss() == 6
+    assert [c.name for c in m.getConss()] == ['c%d' % i for i in range(1, 7)]
+
+    added = m.addConss((v <= 5 for v in x), names = ['ub%d' % i for i in range(5)], return_conss = True)
+    assert [c.name for c in added] == ['ub%d' % i for i in range(5)]
+
+    # on an error, the constraints before the failing one are added, including the staged linear ones
+    nconss = m.getNConss()
+    with pytest.raises(ValueError):
+        m.addConss((v <= 5 for v in x), names = ['short0', 'short1'])
+    assert [c.name for c in m.getConss()[nconss:]] == ['short0', 'short1']
+
+    m.setObjective(quicksum(x), "maximize")
+    m.optimize()
+    assert m.getStatus() == 'optimal'
+
+def test_lookup_by_name():
+    m = Model()
+    x = m.addVar("x")
+    y = m.addVar("y")
+    z = m.addVar("z")
+    c = m.addCons(2*x - y + 3*z <= 4, name = "c")
+
+    assert m.getVarByName("y") is y
+    assert m.getVarByName("w") is None
+    assert m.getConsByName("c") is c
+    assert m.getConsByName("d") is None
+    assert list(m.getVarIndicesByName(["z", "w", "x"])) == [2, -1, 0]
+
+    vars, coefs = m.getValsLinearArray(c)
+    assert dict(zip([v.name for v in vars], coefs)) == m.getValsLinear(c)
+    indices, coefs = m.getValsLinearArray(c, indices = True)
+    assert dict(zip(indices, coefs)) == {0: 2.0, 1: -1.0, 2: 3.0}
+
+    # once transformed, the names of the original variables give the transformed variables
+    m.hideOutput()
+    m.setPresolve(SCIP_PARAMSETTING.OFF)
+    m.presolve()
+    tx = m.getTransformedVar(x)
+    assert m.getVarByName("x") is tx
+    assert m.getVarByName("t_x") is tx
+    tvars = m.getVars(transformed = True)
+    indices = m.getVarIndicesByName(["z", "x", "w"])
+    assert tvars[indices[0]] is m.getTransformedVar(z)
+    assert tvars[indices[1]] is tx
+    assert indices[2] == -1
+    m.freeTransform()
+    assert m.getVarByName("x") is x
+
+
 if __name__ == "__main__":
     test_model()
     test_model_ptr()
+    test_wrapper_interning()
+    test_wrapper_reallocation()
+    test_scratch_memory_released_on_error()
+    test_addConss()
+    test_lookup_by_name()
@@ -9,6 +9,13 @@ class FiFo(Nodesel):
     leaves, children, siblings = self.model.getOpenNodes()
     nodes = leaves + children + siblings
 
+    data = self.model.getOpenNodesArrays()
+    assert list(data["number"]) == [node.getNumber() for node in nodes]
+    assert list(data["depth"]) == [node.getDepth() for node in nodes]
+    assert list(data["lowerbound"]) == [node.getLowerbound() for node in nodes]
+    assert list(data["type"]) == [node.getType() for node in nodes]
+    assert list(data["parent"]) == [node.getParent().getNumber() if node.getParent() else -1 for node in nodes]
+
     return {"selnode" : nodes[0]} if len(nodes) > 0 else {}
 
   def nodecomp(self, node1, node2):
@@ -1,6 +1,7 @@
 import pytest
 
-from pyscipopt import Model, quicksum, sqrt
+from pyscipopt import Model, quicksum, sqrt, exp
+from pyscipopt.scip import expr_to_nodes
 
 # test string with polynomial formulation (uses only Expr)
 def test_string_poly():
@@ -285,9 +286,49 @@ def test_quad_coeffs():
     assert linterms[0][0].name == z.name
     assert linterms[0][1] == 4
 
+def test_shared_subexpressions():
+    """equal subexpressions and variables are lowered only once"""
+    scip = Model()
+    x = scip.addVar(lb=0, ub=1)
+    y = scip.addVar(lb=0, ub=1)
+
+    shared = exp(x + y)
+    expr = shared * shared + shared + exp(x + y) + sqrt(x) * sqrt(y) + x**2
+    nodes = expr_to_nodes(expr)
+    ops = [node[0] for node in nodes]
+    assert ops.count('var') == 2
+    assert ops.count('exp') == 1
+    assert ops.count('sqrt') == 2
+
+    scip.addCons(expr <= 100)
+    scip.setObjective(-x - y)
+    scip.optimize()
+    assert abs(scip.getObjVal() + 2.0) < 1.0e-6
+
+def test_deep_expression():
+    """expressions nested deeper than the recursion limit can be added and evaluated"""
+    import sys
+    scip = Model()
+    x = scip.addVar(lb=0, ub=1)
+
+    expr = sqrt(x + 1)
+    value = 1.0
+    for _ in range(sys.getrecursionlimit()):
+        expr = sqrt(expr + 1)
+        value = (value + 1)**0.5
+    scip.addCons(expr <= 2)
+    assert scip.getNConss() == 1
+
+    # and evaluated
+    sol = scip.createSol()
+    scip.setSolVal(sol, x, 0.0)
+    assert abs(scip.evaluate(expr, sol)[0] - value) <= 1e-9
+
 if __name__ == "__main__":
     test_string_poly()
     test_string()
     test_circle()
     test_gastrans()
     test_quad_coeffs()
+    test_shared_subexpressions()
+    test_deep_expression()
@@ -64,6 +64,49 @@ class CutPricer(Pricer):
             self.data['cons'][i] = self.model.getTransformedCons(c)
 
 
+class CutPricerArrays(CutPricer):
+
+    # The reduced cost function using the array based methods for reading duals and adding columns
+    def pricerredcost(self):
+
+        # Retrieving all dual solutions at once
+        dualSolutions = self.model.getDualsolLinearArray(self.data['cons'])
+
+        subMIP = Model("CuttingStock-Sub")
+        subMIP.setPresolve(SCIP_PARAMSETTING.OFF)
+        subMIP.hideOutput()
+
+        cutWidthVars = [subMIP.addVar("CutWidth_" + str(i), vtype = "I", obj = -1.0 * d) for i, d in enumerate(dualSolutions)]
+        subMIP.addCons(
+            quicksum(w*v for (w,v) in zip(self.data['widths'], cutWidthVars)) <= self.data['rollLength'])
+        subMIP.optimize()
+
+        objval = 1 + subMIP.getObjVal()
+
+        if objval < -1e-08:
+            newPattern = [round(subMIP.getVal(v)) for v in cutWidthVars]
+            rows = [i for i, coeff in enumerate(newPattern) if coeff != 0]
+
+            # invalid input is rejected before any variable is created; exceptions raised here do not reach the
+            # test, so the outcomes are recorded and checked after optimize()
+            nvars = self.model.getNVars()
+            for badptr, badrows in [([1, len(rows)], rows), ([0, len(rows) + 1], rows), ([0, len(rows)], [len(self.data['cons'])] * len(rows))]:
+                try:
+                    self.model.addPricedVars(1.0, 0.0, None, (badptr, badrows, [1.0] * len(rows)), self.data['cons'])
+                    rejected = False
+                except (ValueError, IndexError):
+                    rejected = True
+                self.data['rejected'].append(rejected and self.model.getNVars() == nvars)
+
+            # one column in CSC format
+            newVars = self.model.addPricedVars(1.0, 0.0, None, ([0, len(rows)], rows, [newPattern[i] for i in rows]),
+                                               self.data['cons'], names = ["NewPattern_" + str(len(self.data['var']))])
+
+            self.data['patterns'].append(newPattern)
+            self.data['var'].extend(newVars)
+
+        return {'result':SCIP_RESULT.SUCCESS}
+
 def test_cuttingstock():
     # create solver instance
     s = Model("CuttingStock")
@@ -144,5 +187,37 @@ def test_cuttingstock():
 
     assert s.getObjVal() == 452.25
 
+def test_cuttingstock_arrays():
+    s = Model("CuttingStock")
+    s.setPresolve(0)
+    s.hideOutput()
+
+    pricer = CutPricerArrays()
+    s.includePricer(pricer, "CuttingStockPricer", "Pricer to identify new cutting stock patterns")
+
+    widths = [14, 31, 36, 45]
+    demand = [211, 395, 610, 97]
+    rollLength = 100
+
+    cutPatternVars = [s.addVar("Pattern_" + str(i), obj = 1.0) for i in range(len(widths))]
+    demandCons = []
+    patterns = []
+    for i in range(len(widths)):
+        numWidthsPerRoll = float(int(rollLength/widths[i]))
+        demandCons.append(s.addCons(numWidthsPerRoll*cutPatternVars[i] >= demand[i],
+                                    separate = False, modifiable = True))
+        newPattern = [0]*len(widths)
+        newPattern[i] = numWidthsPerRoll
+        patterns.append(newPattern)
+
+    pricer.data = {'var': cutPatternVars, 'cons': demandCons, 'widths': widths, 'demand': demand,
+                   'rollLength': rollLength, 'patterns': patterns, 'rejected': []}
+
+    s.optimize()
+
+    assert len(pricer.data['var']) > len(widths)
+    assert s.getObjVal() == 452.25
+    assert pricer.data['rejected'] and all(pricer.data['rejected'])
+
 if __name__ == '__main__':
     test_cuttingstock()
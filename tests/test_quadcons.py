@@ -1,3 +1,5 @@
+import numpy as np
+
 from pyscipopt import Model
 
 def test_niceqp():
@@ -27,6 +29,40 @@ def test_niceqcqp():
     assert round(s.getVal(x)) == 1.0
     assert round(s.getVal(y)) == 1.0
 
+def test_quadcons_arrays():
+    s = Model()
+
+    x = s.addVar("x")
+    y = s.addVar("y")
+    # x*x + y*y <= 2 from coordinate arrays and from a dense matrix
+    cons = s.addQuadCons(([0, 1], [0, 1], [1.0, 1.0]), rhs=2.0, vars=[x, y], name="circle")
+    assert cons.isQuadratic()
+    assert cons.name == "circle"
+    s.addQuadCons(np.eye(2), c=[-1.0, 0.0], rhs=1.5)
+    s.setObjective(x + y, sense='maximize')
+
+    s.optimize()
+
+    assert abs(s.getVal(x)**2 + s.getVal(y)**2) <= 2.0 + 1e-6
+    assert abs(s.getVal(x)**2 - s.getVal(x) + s.getVal(y)**2) <= 1.5 + 1e-6
+
+def test_quadobjective_arrays():
+    s = Model()
+
+    x = s.addVar("x", lb=-10)
+    y = s.addVar("y", lb=-10)
+    # minimize (x - 1)^2 + (y + 2)^2 - 5 = x^2 + y^2 - 2x + 4y
+    aux = s.setQuadObjective(([0, 1], [0, 1], [1.0, 1.0]), c=[-2.0, 4.0], vars=[x, y])
+    assert aux.name == "quadobj"
+
+    s.optimize()
+
+    assert abs(s.getVal(x) - 1.0) <= 1e-4
+    assert abs(s.getVal(y) + 2.0) <= 1e-4
+    assert abs(s.getObjVal() + 5.0) <= 1e-4
+
 if __name__ == "__main__":
     test_niceqp()
     test_niceqcqp()
+    test_quadcons_arrays()
+    test_quadobjective_arrays()
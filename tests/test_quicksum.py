@@ -1,4 +1,7 @@
-from pyscipopt import Model, quicksum
+import numpy as np
+import pytest
+
+from pyscipopt import Model, quicksum, quickdot, exp
 from pyscipopt.scip import CONST
 
 def test_quicksum_model():
@@ -34,7 +37,28 @@ def test_largequadratic():
     m.addCons(cons)
     # TODO: what can we test beyond the lack of crashes?
 
+def test_quickdot():
+    m = Model("quickdot")
+    x = [m.addVar("x_%d" % i) for i in range(5)]
+    c = np.arange(1.0, 6.0)
+
+    expr = quickdot(c, x)
+    assert expr.terms == quicksum(c[i]*x[i] for i in range(5)).terms
+
+    # repeated variables and expressions are merged, numbers go to the constant
+    expr = quickdot([1, 2, 3, 4], [x[0], x[0] + x[1], 2*x[1]*x[2], 5])
+    assert expr[x[0]] == 3.0
+    assert expr[x[1]] == 2.0
+    assert expr.terms == (3*x[0] + 2*x[1] + 6*x[1]*x[2] + 20).terms
+
+    genexpr = quickdot([2.0, 1.0], [exp(x[0]), x[1]])
+    assert not isinstance(genexpr, type(expr))
+
+    with pytest.raises(ValueError):
+        quickdot([1.0, 2.0], x)
+
 if __name__ == "__main__":
     test_quicksum()
     test_quicksum_model()
     test_largequadratic()
+    test_quickdot()
@@ -1,7 +1,8 @@
-from pyscipopt import Model
+from pyscipopt import Model, SCIP_RESULT, SCIP_PARAMSETTING
 from pyscipopt.scip import Relax
 
 calls = []
+arraycalls = []
 
 class SoncRelax(Relax):
     def relaxexec(self):
@@ -29,7 +30,32 @@ def test_relax():
     print(m.getVal(x0))
     assert 'relaxexec' in calls
     assert len(calls) == 1
-    
-    
+
+
+class ArrayRelax(Relax):
+    def relaxexec(self):
+        vars = self.model.getVars(transformed=True)
+        self.model.setRelaxSolVals(vars, [1.0, 0.0], includeslp=True, relax=self)
+        arraycalls.append('arrayrelaxexec')
+        return {"result": SCIP_RESULT.SUCCESS, "lowerbound": 1.0}
+
+
+def test_relax_arrays():
+    m = Model()
+    m.hideOutput()
+    m.setPresolve(SCIP_PARAMSETTING.OFF)
+    m.includeRelax(ArrayRelax(), 'testarrayrelaxator', 'Test that relaxation values can be set from arrays')
+
+    x = m.addVar(vtype = "C", name = "x", ub = 1.0)
+    y = m.addVar(vtype = "C", name = "y", ub = 1.0)
+    m.addCons(x + y >= 1)
+
+    m.setObjective(x + y)
+    m.optimize()
+    assert 'arrayrelaxexec' in arraycalls
+    assert m.getObjVal() == 1.0
+
+
 if __name__ == "__main__":
     test_relax()
+    test_relax_arrays()
@@ -1,4 +1,6 @@
-from pyscipopt import Model
+import math
+
+from pyscipopt import Model, exp, log, sqrt
 
 def test_solution_getbest():
     m = Model()
@@ -32,6 +34,33 @@ def test_solution_create():
     s[y] = 4.0
     assert m.addSol(s, free=True)
 
+def test_solution_evaluate():
+    m = Model()
+
+    x = m.addVar("x", lb=1, ub=3)
+    y = m.addVar("y", lb=1, ub=3)
+    m.setObjective(x + y)
+
+    sols = []
+    for xval, yval in [(1.0, 2.0), (2.0, 3.0), (3.0, 1.0)]:
+        s = m.createSol()
+        s[x] = xval
+        s[y] = yval
+        sols.append(s)
+
+    exprs = [x, 2*x*y - 3*y + 1, exp(x) + log(y)*sqrt(x + y), abs(1 - x)**2 / y, 5]
+    vals = m.evaluate(exprs, sols)
+    assert vals.shape == (5, 3)
+    for j, (xval, yval) in enumerate([(1.0, 2.0), (2.0, 3.0), (3.0, 1.0)]):
+        expected = [xval, 2*xval*yval - 3*yval + 1, math.exp(xval) + math.log(yval)*math.sqrt(xval + yval),
+                    abs(1 - xval)**2 / yval, 5]
+        for i in range(len(exprs)):
+            assert abs(vals[i, j] - expected[i]) <= 1e-9
+
+    assert m.evaluate(x + y, sols[0]).shape == (1,)
+    assert abs(m.evaluate(x + y, sols[0])[0] - 3.0) <= 1e-9
+
 if __name__ == "__main__":
     test_solution_getbest()
     test_solution_create()
+    test_solution_evaluate()
@@ -7,6 +7,7 @@ class NodeEventHandler(Eventhdlr):
 
     def __init__(self):
         self.calls = []
+        self.lastbranchings = []
 
     def eventinit(self):
         self.model.catchEvent(SCIP_EVENTTYPE.NODEFOCUSED, self)
@@ -19,6 +20,10 @@ class NodeEventHandler(Eventhdlr):
         assert event.getType() == SCIP_EVENTTYPE.NODEFOCUSED
         node = event.getNode()
         
+        pathindices, pathbounds, pathtypes, pathdepths = node.getPathBoundChanges()
+        assert list(pathdepths) == list(range(1, node.getDepth() + 1))
+        assert len(node.getPathBoundChanges(propagated=True)[0]) >= len(pathindices)
+
         if node.getDepth() == 0:
             assert node.getParent() is None
             assert node.getParentBranchings() is None
@@ -28,6 +33,11 @@ class NodeEventHandler(Eventhdlr):
         assert len(variables) == 1
         assert len(branchbounds) == 1
         assert len(boundtypes) == 1
+        assert branchbounds[0] == pathbounds[-1]
+        assert boundtypes[0] == pathtypes[-1]
+        # the index of a variable that is not active anymore is -1
+        tvars = self.model.getVars(transformed=True)
+        self.lastbranchings.append(pathindices[-1] == -1 or tvars[pathindices[-1]] is variables[0])
         domain_changes = node.getDomchg()
         bound_changes = domain_changes.getBoundchgs()
         assert len(bound_changes) == 1
@@ -61,6 +71,7 @@ def test_tree():
     del s
 
     assert len(node_eventhdlr.calls) > 3
+    assert node_eventhdlr.lastbranchings and all(node_eventhdlr.lastbranchings)
 
 if __name__ == "__main__":
     test_tree()
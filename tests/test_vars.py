@@ -66,6 +66,61 @@ def test_vtype():
     m.chgVarType(y, 'M')
     assert y.vtype() == "IMPLINT"
 
+def test_tightenvarbounds():
+    m = Model()
+
+    x = m.addVar(lb=-5, ub=8)
+    y = m.addVar(lb=0, ub=10)
+    z = m.addVar(lb=1, ub=2)
+
+    infeas, ntightened, status = m.tightenVarBounds([0, 1, 2], [-6, 2, float("-inf")], [7, 12, float("inf")],
+                                                    vars=[x, y, z], return_status=True)
+    assert not infeas
+    assert ntightened == 2
+    assert list(status) == [2, 1, 0]
+    assert x.getUbOriginal() == 7
+    assert y.getLbOriginal() == 2
+
+    infeas, ntightened = m.tightenVarBounds([2], 3, float("inf"), vars=[x, y, z])
+    assert infeas
+
+def test_bulkbounds():
+    m = Model()
+
+    x = m.addVar(lb=0, ub=10)
+    y = m.addVar(lb=0, ub=10)
+    z = m.addVar(lb=0, ub=10)
+    w = m.addVar(lb=0, ub=1)
+
+    infeasible, redundant = m.chgVarBounds([x, y, z, w], [2, float("nan"), 0, 5], [4, 6, 10, 3])
+    assert list(infeasible) == [False, False, False, True]
+    assert list(redundant) == [False, False, True, False]
+    assert (x.getLbOriginal(), x.getUbOriginal()) == (2, 4)
+    assert (y.getLbOriginal(), y.getUbOriginal()) == (0, 6)
+    assert (w.getLbOriginal(), w.getUbOriginal()) == (0, 1)
+
+    # a lower bound above the old upper bound is applied after the upper bound
+    infeasible, redundant = m.chgVarBounds([w], 5, 7, scope='orig')
+    assert not infeasible[0] and not redundant[0]
+    assert (w.getLbOriginal(), w.getUbOriginal()) == (5, 7)
+
+    infeasible, redundant = m.chgVarBounds([x, y], ubs=float("inf"), scope='global')
+    assert not any(infeasible)
+    assert x.getUbGlobal() >= m.infinity()
+
+    # in the problem stage, the bounds are set to the fix value regardless of the current bounds
+    infeasible, fixed = m.fixVars([x, z], [3, 11])
+    assert list(infeasible) == [False, False]
+    assert list(fixed) == [True, True]
+    assert (z.getLbOriginal(), z.getUbOriginal()) == (11, 11)
+
+    infeasible = m.chgVarTypes([y, w], 'I')
+    assert not any(infeasible)
+    assert y.vtype() == "INTEGER"
+    assert w.vtype() == "INTEGER"
+
 if __name__ == "__main__":
     test_variablebounds()
     test_vtype()
+    test_tightenvarbounds()
+    test_bulkbounds()